@@ -0,0 +1,297 @@
+#include <nil/gate.hpp>
+#include <nil/gate/runners/Immediate.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+// microbenchmarks of the propagation path, no probe installed.
+// run with `--benchmark_filter=<name>` to select a group.
+namespace
+{
+    struct Samples
+    {
+        std::vector<double> values;
+
+        bool operator==(const Samples&) const = default;
+    };
+
+    Samples make_samples(std::int64_t size, double offset)
+    {
+        Samples s;
+        s.values.resize(std::size_t(size));
+        std::iota(s.values.begin(), s.values.end(), offset);
+        return s;
+    }
+
+    // builds `chain` nodes after `source`, each consuming the output of the previous one
+    template <typename Callback>
+    void build_chain(
+        nil::gate::Graph& graph,
+        nil::gate::ports::External<int>* source,
+        std::int64_t chain,
+        Callback on_node
+    )
+    {
+        nil::gate::ports::ReadOnly<int>* last = nullptr;
+        {
+            auto* node = graph.node([](int v) { return v + 1; }, {source});
+            std::tie(last) = node->outputs();
+            on_node(node);
+        }
+        for (std::int64_t i = 1; i < chain; ++i)
+        {
+            auto* node = graph.node([](int v) { return v + 1; }, {last});
+            std::tie(last) = node->outputs();
+            on_node(node);
+        }
+    }
+}
+
+template <>
+struct nil::gate::traits::compatibility<std::vector<double>, Samples>
+{
+    // by reference, the adapter keeps a pointer
+    static const std::vector<double>& convert(const Samples& s)
+    {
+        return s.values;
+    }
+};
+
+template <>
+struct nil::gate::traits::compatibility<std::vector<float>, Samples>
+{
+    // by value, the adapter keeps a cached copy
+    static std::vector<float> convert(const Samples& s)
+    {
+        return {s.values.begin(), s.values.end()};
+    }
+};
+
+// Port::set_value
+
+static void port_set_value_changed(benchmark::State& state)
+{
+    nil::gate::detail::Port<int> port(0);
+    int value = 0;
+    for (auto _ : state)
+    {
+        port.set_value(++value);
+    }
+    benchmark::DoNotOptimize(port.value());
+}
+
+BENCHMARK(port_set_value_changed);
+
+static void port_set_value_unchanged(benchmark::State& state)
+{
+    nil::gate::detail::Port<int> port(0);
+    for (auto _ : state)
+    {
+        port.set_value(0);
+    }
+    benchmark::DoNotOptimize(port.value());
+}
+
+BENCHMARK(port_set_value_unchanged);
+
+// the compare dominates for large values, unchanged values are not moved in
+static void port_set_value_samples(benchmark::State& state)
+{
+    const auto changed = state.range(1) != 0;
+    const auto a = make_samples(state.range(0), 0.0);
+    const auto b = make_samples(state.range(0), changed ? 1.0 : 0.0);
+    nil::gate::detail::Port<Samples> port(a);
+    bool flip = false;
+    for (auto _ : state)
+    {
+        port.set_value((flip = !flip) ? b : a);
+    }
+    benchmark::DoNotOptimize(port.value());
+}
+
+BENCHMARK(port_set_value_samples)
+    ->ArgsProduct({{16, 1024}, {0, 1}})
+    ->ArgNames({"size", "changed"});
+
+// pend/done traversal, as done by the runners around the execution of a commit
+
+static void pend_done_chain(benchmark::State& state)
+{
+    nil::gate::runners::Immediate runner;
+    nil::gate::Core core(&runner);
+
+    nil::gate::ports::External<int>* source = nullptr;
+    std::vector<nil::gate::INode*> nodes;
+    core.apply(
+        [&](nil::gate::Graph& graph)
+        {
+            source = graph.port(0);
+            build_chain(
+                graph,
+                source,
+                state.range(0),
+                [&](nil::gate::INode* n) { nodes.push_back(n); }
+            );
+        }
+    );
+
+    auto* port = static_cast<nil::gate::detail::Port<int>*>(source->to_direct());
+    for (auto _ : state)
+    {
+        port->pend();
+        port->done();
+        for (auto* node : nodes)
+        {
+            node->done();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(pend_done_chain)->RangeMultiplier(8)->Range(8, 4096);
+
+// Node::exec dispatch through each call() variant, the output does not change
+
+template <typename Fn>
+static void node_exec(benchmark::State& state, Fn fn)
+{
+    nil::gate::runners::Immediate runner;
+    nil::gate::Core core(&runner);
+
+    nil::gate::INode* node = nullptr;
+    core.apply([&](nil::gate::Graph& graph) { node = graph.node(fn, {graph.port(1)}); });
+
+    for (auto _ : state)
+    {
+        node->exec();
+    }
+}
+
+BENCHMARK_CAPTURE(node_exec, plain, [](int v) { return v + 1; });
+BENCHMARK_CAPTURE(node_exec, core, [](nil::gate::Core& /* core */, int v) { return v + 1; });
+BENCHMARK_CAPTURE(
+    node_exec,
+    opt,
+    [](nil::gate::opt_outputs<int> /* o */, int v) { return v + 1; }
+);
+BENCHMARK_CAPTURE(
+    node_exec,
+    core_opt,
+    [](nil::gate::Core& /* core */, nil::gate::opt_outputs<int> /* o */, int v) { return v + 1; }
+);
+BENCHMARK_CAPTURE(
+    node_exec,
+    tuple,
+    [](int v) { return std::make_tuple(v + 1, v + 2); }
+);
+
+// Compatible adapters, converted on every change of the source port
+
+template <typename TO>
+static void compatible_set_value(benchmark::State& state)
+{
+    nil::gate::runners::Immediate runner;
+    nil::gate::Core core(&runner);
+
+    const auto a = make_samples(state.range(0), 0.0);
+    const auto b = make_samples(state.range(0), 1.0);
+
+    nil::gate::ports::External<Samples>* source = nullptr;
+    core.apply(
+        [&](nil::gate::Graph& graph)
+        {
+            source = graph.port(a);
+            graph.node([](const TO& v) { benchmark::DoNotOptimize(v.data()); }, {source});
+        }
+    );
+
+    auto* port = source->to_direct();
+    bool flip = false;
+    for (auto _ : state)
+    {
+        port->set_value((flip = !flip) ? b : a);
+    }
+}
+
+BENCHMARK(compatible_set_value<std::vector<double>>)
+    ->Name("compatible_set_value/reference")
+    ->Arg(16)
+    ->Arg(1024);
+BENCHMARK(compatible_set_value<std::vector<float>>)
+    ->Name("compatible_set_value/cached")
+    ->Arg(16)
+    ->Arg(1024);
+
+// Core::commit adding and removing a node, which makes it sort the graph again
+// (Graph::sort is only reachable through Core::commit).
+// `resort:0` is the same commit without a change of the graph, as a baseline.
+// the difference is the cost of the sort plus adding and removing the node.
+
+static void commit_resort(benchmark::State& state)
+{
+    nil::gate::runners::Immediate runner;
+    nil::gate::Core core(&runner);
+    core.apply([&](nil::gate::Graph& graph)
+               { build_chain(graph, graph.port(0), state.range(0), [](auto*) {}); });
+
+    const auto resort = state.range(1) != 0;
+    for (auto _ : state)
+    {
+        if (resort)
+        {
+            core.apply([](nil::gate::Graph& graph)
+                       { graph.remove(graph.node([]() { return 0; })); });
+        }
+        else
+        {
+            core.apply([]() {});
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(commit_resort)->ArgsProduct({{64, 1024, 8192}, {0, 1}})->ArgNames({"nodes", "resort"});
+
+// UNode execution, fan-in of `inputs`
+
+static void unode_exec(benchmark::State& state)
+{
+    nil::gate::runners::Immediate runner;
+    nil::gate::Core core(&runner);
+
+    nil::gate::INode* node = nullptr;
+    core.apply(
+        [&](nil::gate::Graph& graph)
+        {
+            std::vector<nil::gate::ports::Compatible<int>> inputs;
+            for (std::int64_t i = 0; i < state.range(0); ++i)
+            {
+                inputs.emplace_back(graph.port(int(i)));
+            }
+            node = graph.unode<int>({
+                .inputs = std::move(inputs),
+                .output_size = 1,
+                .fn =
+                    [](const nil::gate::UNode<int>::Arg& arg)
+                {
+                    int sum = 0;
+                    for (const auto* i : arg.inputs)
+                    {
+                        sum += *i;
+                    }
+                    arg.outputs[0]->set_value(sum);
+                },
+            });
+        }
+    );
+
+    for (auto _ : state)
+    {
+        node->exec();
+    }
+}
+
+BENCHMARK(unode_exec)->Arg(1)->Arg(8)->Arg(64);
@@ -0,0 +1,462 @@
+#include <nil/gate.hpp>
+#include <nil/gate/Topology.hpp>
+#include <nil/gate/probes/Histogram.hpp>
+#include <nil/gate/runners/Async.hpp>
+#include <nil/gate/runners/Immediate.hpp>
+#include <nil/gate/runners/SoftBlocking.hpp>
+#include <nil/gate/runners/boost_asio/Async.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// commit throughput and latency of the runners over synthetic graphs, as CSV on stdout.
+//
+// every node spins for `cost` and outputs the max of its inputs + 1, so a change of the source
+// reaches every node. a sink UNode reading all of the leaves marks the end of a commit.
+// - latency: one commit at a time, from the commit call until the sink has the new value.
+// - throughput: `commits` commits back to back, then waits for the last one.
+//   Async runners merge commits requested while busy, `passes` counts the graph executions.
+//   `commits_per_s` is then mostly the cost of `commit`, compare the runners on `passes_per_s`.
+namespace
+{
+    using value_t = std::uint64_t;
+    using clock = std::chrono::steady_clock;
+
+    enum class EShape
+    {
+        FanOut,  // `nodes` nodes reading the root
+        Chain,   // `nodes` nodes, each reading the previous one
+        Diamond, // layers of `width` nodes, each reading two neighbours of the previous layer
+        Random   // layers of `width` nodes, each reading 1 to 3 random nodes of the upper layers
+    };
+
+    constexpr std::string_view shape_names[] = {"fanout", "chain", "diamond", "random"};
+    constexpr std::string_view runner_names[] = {"immediate", "soft_blocking", "async", "asio"};
+
+    struct Options
+    {
+        std::vector<EShape> shapes
+            = {EShape::FanOut, EShape::Chain, EShape::Diamond, EShape::Random};
+        std::vector<std::string> runners = {"immediate", "soft_blocking", "async", "asio"};
+        std::vector<std::size_t> threads = {1, 2, 4, 8};
+        std::size_t nodes = 256;
+        std::size_t width = 16;
+        std::chrono::nanoseconds cost = std::chrono::microseconds(1);
+        std::size_t commits = 1000;
+        std::uint32_t seed = 1;
+    };
+
+    struct Sink
+    {
+        std::atomic<value_t> value = 0;
+        std::atomic<std::uint64_t> passes = 0;
+    };
+
+    struct Row
+    {
+        std::size_t nodes = 0;
+        std::uint32_t depth = 0;
+        double commits_per_s = 0.0;
+        std::uint64_t passes = 0;
+        double passes_per_s = 0.0;
+        nil::gate::probes::Histogram latency;
+    };
+
+    void spin(std::chrono::nanoseconds cost)
+    {
+        if (cost.count() == 0)
+        {
+            return;
+        }
+        const auto end = clock::now() + cost;
+        while (clock::now() < end)
+        {
+        }
+    }
+
+    template <typename Node>
+    nil::gate::ports::ReadOnly<value_t>* output_of(Node* node)
+    {
+        return std::get<0>(node->outputs());
+    }
+
+    nil::gate::ports::External<value_t>* build(
+        nil::gate::Graph& graph,
+        const Options& options,
+        EShape shape,
+        Sink& sink
+    )
+    {
+        using port_t = nil::gate::ports::ReadOnly<value_t>*;
+        const auto cost = options.cost;
+        const auto one = [cost](value_t a)
+        {
+            spin(cost);
+            return a + 1;
+        };
+        const auto two = [cost](value_t a, value_t b)
+        {
+            spin(cost);
+            return std::max(a, b) + 1;
+        };
+        const auto three = [cost](value_t a, value_t b, value_t c)
+        {
+            spin(cost);
+            return std::max({a, b, c}) + 1;
+        };
+
+        auto* source = graph.port(value_t(0));
+        auto* root = output_of(graph.node(one, {source}));
+
+        const auto width = std::max<std::size_t>(1, std::min(options.width, options.nodes));
+        const auto layers = std::max<std::size_t>(1, options.nodes / width);
+
+        std::vector<port_t> leaves;
+        switch (shape)
+        {
+            case EShape::FanOut:
+            {
+                for (std::size_t i = 0; i < options.nodes; ++i)
+                {
+                    leaves.push_back(output_of(graph.node(one, {root})));
+                }
+                break;
+            }
+            case EShape::Chain:
+            {
+                auto* last = root;
+                for (std::size_t i = 0; i < options.nodes; ++i)
+                {
+                    last = output_of(graph.node(one, {last}));
+                }
+                leaves.push_back(last);
+                break;
+            }
+            case EShape::Diamond:
+            {
+                std::vector<port_t> previous(width, root);
+                for (std::size_t l = 0; l < layers; ++l)
+                {
+                    std::vector<port_t> current;
+                    for (std::size_t i = 0; i < width; ++i)
+                    {
+                        auto* a = previous[i];
+                        auto* b = previous[(i + 1) % width];
+                        current.push_back(
+                            a == b ? output_of(graph.node(one, {a}))
+                                   : output_of(graph.node(two, {a, b}))
+                        );
+                    }
+                    previous = std::move(current);
+                }
+                leaves = std::move(previous);
+                break;
+            }
+            case EShape::Random:
+            {
+                std::mt19937 random(options.seed);
+                std::vector<port_t> upper = {root};
+                std::vector<bool> consumed = {false};
+                std::size_t layer_begin = 0;
+                for (std::size_t l = 0; l < layers; ++l)
+                {
+                    const auto layer_end = upper.size();
+                    for (std::size_t i = 0; i < width; ++i)
+                    {
+                        // the first input comes from the previous layer to keep the layering
+                        const auto pick = [&](std::size_t from)
+                        {
+                            std::uniform_int_distribution<std::size_t> d(from, layer_end - 1);
+                            const auto index = d(random);
+                            consumed[index] = true;
+                            return upper[index];
+                        };
+                        const auto count = std::uniform_int_distribution<int>(1, 3)(random);
+                        auto* a = pick(layer_begin);
+                        port_t port = nullptr;
+                        if (count == 1)
+                        {
+                            port = output_of(graph.node(one, {a}));
+                        }
+                        else if (count == 2)
+                        {
+                            port = output_of(graph.node(two, {a, pick(0)}));
+                        }
+                        else
+                        {
+                            port = output_of(graph.node(three, {a, pick(0), pick(0)}));
+                        }
+                        upper.push_back(port);
+                        consumed.push_back(false);
+                    }
+                    layer_begin = layer_end;
+                }
+                for (std::size_t i = 0; i < upper.size(); ++i)
+                {
+                    if (!consumed[i])
+                    {
+                        leaves.push_back(upper[i]);
+                    }
+                }
+                break;
+            }
+        }
+
+        std::vector<nil::gate::ports::Compatible<value_t>> inputs(leaves.begin(), leaves.end());
+        graph.unode<value_t>({
+            .inputs = std::move(inputs),
+            .output_size = 0,
+            .fn =
+                [&sink](const nil::gate::UNode<value_t>::Arg& arg)
+            {
+                value_t value = 0;
+                for (const auto* i : arg.inputs)
+                {
+                    value = std::max(value, *i);
+                }
+                // value first, a reader seeing the pass also sees its value
+                sink.value.store(value);
+                sink.passes.fetch_add(1);
+                sink.value.notify_all();
+                sink.passes.notify_all();
+            },
+        });
+        return source;
+    }
+
+    void wait_for(const Sink& sink, value_t expected)
+    {
+        auto value = sink.value.load();
+        while (value < expected)
+        {
+            sink.value.wait(value);
+            value = sink.value.load();
+        }
+    }
+
+    template <typename Runner, typename... Args>
+    Row measure(const Options& options, EShape shape, Args... args)
+    {
+        // the core (and the sink) outlive the runner, whose threads may still be finishing
+        // the last commit
+        Sink sink;
+        nil::gate::Core core;
+        Runner runner(args...);
+        core.set_runner(&runner);
+
+        Row row;
+        nil::gate::ports::External<value_t>* source = nullptr;
+        core.apply(
+            [&](nil::gate::Graph& graph)
+            {
+                source = build(graph, options, shape, sink);
+                const auto topology = nil::gate::Topology::of(graph);
+                row.nodes = topology.node_count;
+                row.depth = topology.depth;
+            }
+        );
+        sink.passes.wait(0);
+
+        // every node adds 1 to the max of its inputs, the sink follows the source with an offset
+        const auto offset = sink.value.load();
+        auto* port = source->to_direct();
+        value_t next = 0;
+        const auto commit = [&]()
+        {
+            core.post([port, v = ++next]() { port->set_value(v); });
+            core.commit();
+        };
+
+        for (std::size_t i = 0; i < options.commits; ++i)
+        {
+            const auto start = clock::now();
+            commit();
+            wait_for(sink, next + offset);
+            row.latency.record(clock::now() - start);
+        }
+
+        const auto passes = sink.passes.load();
+        const auto start = clock::now();
+        for (std::size_t i = 0; i < options.commits; ++i)
+        {
+            commit();
+        }
+        wait_for(sink, next + offset);
+        const auto elapsed = std::chrono::duration<double>(clock::now() - start);
+        row.commits_per_s = double(options.commits) / elapsed.count();
+        row.passes = sink.passes.load() - passes;
+        row.passes_per_s = double(row.passes) / elapsed.count();
+        return row;
+    }
+
+    std::vector<std::string> split(std::string_view value)
+    {
+        std::vector<std::string> result;
+        std::stringstream ss{std::string(value)};
+        for (std::string item; std::getline(ss, item, ',');)
+        {
+            if (!item.empty())
+            {
+                result.push_back(item);
+            }
+        }
+        return result;
+    }
+
+    std::optional<Options> parse(int argc, char** argv)
+    {
+        Options options;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string_view arg = argv[i]; // NOLINT
+            const auto eq = arg.find('=');
+            if (!arg.starts_with("--") || eq == std::string_view::npos)
+            {
+                return std::nullopt;
+            }
+            const auto key = arg.substr(2, eq - 2);
+            const auto value = arg.substr(eq + 1);
+            const auto number = [&]() { return std::stoull(std::string(value)); };
+
+            if (key == "shapes")
+            {
+                options.shapes.clear();
+                for (const auto& name : split(value))
+                {
+                    const auto* it
+                        = std::find(std::begin(shape_names), std::end(shape_names), name);
+                    if (it == std::end(shape_names))
+                    {
+                        return std::nullopt;
+                    }
+                    options.shapes.push_back(EShape(it - std::begin(shape_names)));
+                }
+            }
+            else if (key == "runners")
+            {
+                options.runners = split(value);
+                for (const auto& name : options.runners)
+                {
+                    if (std::find(std::begin(runner_names), std::end(runner_names), name)
+                        == std::end(runner_names))
+                    {
+                        return std::nullopt;
+                    }
+                }
+            }
+            else if (key == "threads")
+            {
+                options.threads.clear();
+                for (const auto& n : split(value))
+                {
+                    options.threads.push_back(std::max<std::size_t>(1, std::stoull(n)));
+                }
+            }
+            else if (key == "nodes")
+            {
+                options.nodes = std::max<std::size_t>(1, number());
+            }
+            else if (key == "width")
+            {
+                options.width = std::max<std::size_t>(1, number());
+            }
+            else if (key == "cost")
+            {
+                options.cost = std::chrono::nanoseconds(number());
+            }
+            else if (key == "commits")
+            {
+                options.commits = std::max<std::size_t>(1, number());
+            }
+            else if (key == "seed")
+            {
+                options.seed = std::uint32_t(number());
+            }
+            else
+            {
+                return std::nullopt;
+            }
+        }
+        return options;
+    }
+
+    void print(
+        std::string_view runner,
+        std::size_t threads,
+        EShape shape,
+        const Options& options,
+        const Row& row
+    )
+    {
+        const auto us = [](std::chrono::nanoseconds ns) { return double(ns.count()) / 1000.0; };
+        std::cout << runner << ',' << threads << ',' << shape_names[int(shape)] << ','
+                  << row.nodes << ',' << row.depth << ',' << options.cost.count() << ','
+                  << options.commits << ',' << row.commits_per_s << ',' << row.passes << ','
+                  << row.passes_per_s << ','
+                  << us(row.latency.mean()) << ',' << us(row.latency.percentile(50)) << ','
+                  << us(row.latency.percentile(99)) << ',' << us(row.latency.max()) << std::endl;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::optional<Options> options;
+    try
+    {
+        options = parse(argc, argv);
+    }
+    catch (const std::exception&) // malformed number
+    {
+    }
+    if (!options.has_value())
+    {
+        std::cerr << "usage: " << argv[0] // NOLINT
+                  << " [--shapes=fanout,chain,diamond,random]"
+                     " [--runners=immediate,soft_blocking,async,asio]"
+                     " [--threads=1,2,4,8] [--nodes=256] [--width=16]"
+                     " [--cost=<ns per node, 1000>] [--commits=1000] [--seed=1]\n";
+        return 1;
+    }
+
+    std::cout << "runner,threads,shape,nodes,depth,cost_ns,commits,commits_per_s,passes,passes_per_s,"
+                 "latency_mean_us,latency_p50_us,latency_p99_us,latency_max_us"
+              << std::endl;
+    for (const auto shape : options->shapes)
+    {
+        for (const auto& runner : options->runners)
+        {
+            // immediate and soft_blocking execute on the committing thread
+            if (runner == "immediate")
+            {
+                const auto row = measure<nil::gate::runners::Immediate>(*options, shape);
+                print(runner, 1, shape, *options, row);
+            }
+            else if (runner == "soft_blocking")
+            {
+                const auto row = measure<nil::gate::runners::SoftBlocking>(*options, shape);
+                print(runner, 1, shape, *options, row);
+            }
+            else
+            {
+                for (const auto threads : options->threads)
+                {
+                    const auto row = runner == "async"
+                        ? measure<nil::gate::runners::Async>(*options, shape, threads)
+                        : measure<nil::gate::runners::boost_asio::Async>(*options, shape, threads);
+                    print(runner, threads, shape, *options, row);
+                }
+            }
+        }
+    }
+    return 0;
+}
@@ -19,6 +19,33 @@ ffi.cdef [[
     void nil_gate_core_set_runner_soft_blocking(nil_gate_core core);
     void nil_gate_core_set_runner_async(nil_gate_core core, uint32_t thread_count);
     void nil_gate_core_unset_runner(nil_gate_core core);
+    void nil_gate_core_set_runner_host(nil_gate_core core);
+
+    typedef struct nil_gate_task
+    {
+        void* handle;
+    } nil_gate_task;
+
+    void nil_gate_task_run(nil_gate_task task);
+
+    typedef struct nil_gate_executor
+    {
+        void (*post)(nil_gate_task task, void* context);
+        void* context;
+        void (*cleanup)(void*);
+    } nil_gate_executor;
+
+    void nil_gate_core_set_executor(nil_gate_core core, uint32_t tag, nil_gate_executor executor);
+
+    typedef struct nil_gate_task_queue
+    {
+        void* handle;
+    } nil_gate_task_queue;
+
+    nil_gate_task_queue nil_gate_task_queue_create(void);
+    void nil_gate_task_queue_destroy(nil_gate_task_queue queue);
+    nil_gate_executor nil_gate_task_queue_executor(nil_gate_task_queue queue);
+    size_t nil_gate_task_queue_run(nil_gate_task_queue queue, uint32_t timeout_ms);
 
     typedef struct nil_gate_graph
     {
@@ -116,8 +143,18 @@ ffi.cdef [[
         nil_gate_node_info node_info
     );
 
+    typedef struct nil_gate_node_batch
+    {
+        size_t size;
+        const nil_gate_node_args* const* args;
+    } nil_gate_node_batch;
+
+    nil_gate_node_batch nil_gate_core_next(nil_gate_core core);
+    void nil_gate_core_done(nil_gate_core core);
+
     uint8_t nil_gate_node_output_size(nil_gate_node node);
     void nil_gate_node_outputs(nil_gate_node node, nil_gate_rport* outputs);
+    void nil_gate_node_set_affinity(nil_gate_node node, uint32_t tag);
 
     const void* nil_gate_rport_value(nil_gate_rport port);
     int nil_gate_rport_has_value(nil_gate_rport port);
@@ -130,12 +167,130 @@ ffi.cdef [[
     nil_gate_rport nil_gate_eport_as_input(nil_gate_eport port);
 
     nil_gate_mport nil_gate_eport_to_direct(nil_gate_eport port);
+
+    typedef struct nil_gate_blob
+    {
+        size_t size;
+        const void* data;
+    } nil_gate_blob;
+
+    int nil_gate_port_eq_i64(const void* l, const void* r);
+    void nil_gate_port_destroy_i64(void* value);
+    int nil_gate_port_eq_f64(const void* l, const void* r);
+    void nil_gate_port_destroy_f64(void* value);
+    int nil_gate_port_eq_bool(const void* l, const void* r);
+    void nil_gate_port_destroy_bool(void* value);
+    int nil_gate_port_eq_blob(const void* l, const void* r);
+    void nil_gate_port_destroy_blob(void* value);
+
+    nil_gate_eport nil_gate_graph_port_i64(nil_gate_graph graph, int64_t initial_value);
+    nil_gate_eport nil_gate_graph_port_f64(nil_gate_graph graph, double initial_value);
+    nil_gate_eport nil_gate_graph_port_bool(nil_gate_graph graph, int initial_value);
+    nil_gate_eport nil_gate_graph_port_blob(nil_gate_graph graph, const void* data, size_t size);
+
+    void nil_gate_mport_set_i64(nil_gate_mport port, int64_t new_value);
+    void nil_gate_mport_set_f64(nil_gate_mport port, double new_value);
+    void nil_gate_mport_set_bool(nil_gate_mport port, int new_value);
+    void nil_gate_mport_set_blob(nil_gate_mport port, const void* data, size_t size);
+
+    void nil_gate_mports_set_values(
+        const nil_gate_mport* ports,
+        void* const* new_values,
+        size_t count
+    );
+    void nil_gate_mports_set_i64(const nil_gate_mport* ports, const int64_t* new_values, size_t count);
+    void nil_gate_mports_set_f64(const nil_gate_mport* ports, const double* new_values, size_t count);
+    void nil_gate_mports_set_bool(const nil_gate_mport* ports, const int* new_values, size_t count);
+
+    void nil_gate_rports_values(const nil_gate_rport* ports, const void** values, size_t count);
+    size_t nil_gate_rports_changed(
+        const nil_gate_rport* ports,
+        uint64_t* versions,
+        uint8_t* changed,
+        size_t count
+    );
 ]]
 
 local function to_ref_id(id)
     return tonumber(ffi.cast("uintptr_t", id))
 end
 
+-- built-in port kinds. values are stored and compared natively by the library.
+local kinds = {
+    i64 = {
+        name = "i64",
+        ctype = "int64_t",
+        read = function(ptr) return tonumber(ffi.cast("const int64_t*", ptr)[0]) end,
+        write = function(v) return v end
+    },
+    f64 = {
+        name = "f64",
+        ctype = "double",
+        read = function(ptr) return ffi.cast("const double*", ptr)[0] end,
+        write = function(v) return v end
+    },
+    bool = {
+        name = "bool",
+        ctype = "int",
+        read = function(ptr) return ffi.cast("const int*", ptr)[0] ~= 0 end,
+        write = function(v) return v and 1 or 0 end
+    },
+    blob = {
+        name = "blob",
+        read = function(ptr)
+            local blob = ffi.cast("const nil_gate_blob*", ptr)
+            return ffi.string(ffi.cast("const char*", blob.data), blob.size)
+        end,
+        -- data and size to copy into the library
+        bytes = function(v) return v, #v end
+    }
+}
+
+local kind_set = {}
+for _, kind in pairs(kinds) do
+    kind_set[kind] = true
+end
+
+-- cdata kinds are blobs of a fixed-size ctype. the bytes are copied into the port
+-- and compared with memcmp. values are read back as a new cdata of the ctype.
+local function cdata(ct)
+    ct = ffi.typeof(ct)
+    local size = ffi.sizeof(ct)
+    assert(size ~= nil, "cdata kinds need a fixed-size ctype")
+    local kind = {
+        name = "blob",
+        read = function(ptr)
+            local blob = ffi.cast("const nil_gate_blob*", ptr)
+            local v = ct()
+            ffi.copy(v, blob.data, size)
+            return v
+        end,
+        bytes = function(v)
+            if not ffi.istype(ct, v) then
+                v = ct(v)
+            end
+            return v, size
+        end
+    }
+    kind_set[kind] = true
+    return kind
+end
+
+local function fn_address(fn)
+    return tonumber(ffi.cast("uintptr_t", ffi.cast("void*", fn)))
+end
+
+local function is_kind(eq)
+    return kind_set[eq] ~= nil
+end
+
+local function read_value(refs, kind, ptr)
+    if kind ~= nil then
+        return kind.read(ptr)
+    end
+    return refs[to_ref_id(ptr)].value
+end
+
 local function current_file_dir()
     local source = debug.getinfo(1, "S").source
     if source:sub(1, 1) == "@" then
@@ -166,10 +321,17 @@ end
 ---@field to_direct fun(self: nil_gate.EPort): nil_gate.MPort
 ----@field as_input fun(self: nil_gate.EPort): nil_gate.RPort
 
----@alias nil_gate.TypeID fun(l, r): boolean
+---@alias nil_gate.TypeID (fun(l, r): boolean) | nil_gate.Kind
+
+---@class nil_gate.Kind
+---@field name string
 
 ---@class nil_gate.Node
 ---@field outputs fun(self: nil_gate.Node): nil_gate.RPort[]
+---@field set_affinity fun(self: nil_gate.Node, tag: integer)
+
+---@class nil_gate.Executor
+---@field run fun(self: nil_gate.Executor, timeout_ms?: integer): integer
 
 ---@class nil_gate.NodeArgs
 ---@field core nil_gate.Core
@@ -180,19 +342,26 @@ end
 ---@field port fun(self: nil_gate.Graph, eq: nil_gate.TypeID, value?: unknown): nil_gate.EPort
 ---@field node fun(self: nil_gate.Graph, fn: (fun(args: nil_gate.NodeArgs)), inputs: (nil_gate.RPort | nil_gate.MPort | nil_gate.EPort)[], outputs: nil_gate.TypeID[]): nil_gate.Node
 
+---@class nil_gate.Changes
+---@field poll fun(self: nil_gate.Changes): integer[]
+
 ---@class nil_gate.Core
 ---@field commit fun(self: nil_gate.Core)
 ---@field post fun(self: nil_gate.Core, fn: fun(graph: nil_gate.Graph))
 ---@field apply fun(self: nil_gate.Core, fn: fun(graph: nil_gate.Graph))
+---@field executor fun(self: nil_gate.Core, tag: integer): nil_gate.Executor
 ---@field destroy fun(self: nil_gate.Core)
 
 ---@class nil_gate.RPort
-local function create_rport(refs, gate, rport)
+local function create_rport(refs, gate, rport, kind)
     return {
+        _refs = refs,
         _port = rport,
+        -- cdata kinds share the `eq` of blob, so the kind can not always be found from the port info
+        _kind = kind or gate.kinds_by_eq[fn_address(rport.info.eq)],
         value = function(self)
             local rid = gate.nil_gate_rport_value(self._port)
-            return refs[to_ref_id(rid)].value
+            return read_value(refs, self._kind, rid)
         end,
         has_value = function(self)
             return gate.nil_gate_rport_has_value(self._port) ~= 0
@@ -206,17 +375,29 @@ end
 ---@return nil_gate.MPort
 local function create_mport(refs, gate, mport, eq)
     return {
+        _refs = refs,
+        _eq = eq,
         _port = mport,
         value = function(self)
             local rport = gate.nil_gate_mport_as_input(self._port);
             local rid = gate.nil_gate_rport_value(rport)
-            return refs[to_ref_id(rid)].value
+            return read_value(refs, is_kind(eq) and eq or nil, rid)
         end,
         has_value = function(self)
             local rport = gate.nil_gate_mport_as_input(self._port);
             return gate.nil_gate_rport_has_value(rport) ~= 0
         end,
         set_value = function(self, new_value)
+            if is_kind(eq) and eq.bytes ~= nil then
+                local data, size = eq.bytes(new_value)
+                gate.nil_gate_mport_set_blob(self._port, data, size)
+                return
+            end
+            if is_kind(eq) then
+                gate["nil_gate_mport_set_" .. eq.name](self._port, eq.write(new_value))
+                return
+            end
+
             local new_id = ffi.C.malloc(1)
             refs[to_ref_id(new_id)] = { value = new_value, eq = eq }
             gate.nil_gate_mport_set_value(self._port, new_id)
@@ -225,42 +406,57 @@ local function create_mport(refs, gate, mport, eq)
             gate.nil_gate_mport_unset_value(self._port)
         end,
         as_input = function(self)
-            return create_rport(refs, gate, gate.nil_gate_mport_as_input(self._port))
+            return create_rport(refs, gate, gate.nil_gate_mport_as_input(self._port), is_kind(eq) and eq or nil)
         end
     }
 end
 
 ---@return nil_gate.EPort
 local function create_lua_eport(refs, lua_fns, gate, graph, eq, value)
-    local port_info = ffi.new("nil_gate_port_info")
-    local id = nil
+    local port = nil
+
+    if is_kind(eq) then
+        if value == nil then
+            port = gate.nil_gate_graph_port(graph, gate.kind_info(eq), nil)
+        elseif eq.bytes ~= nil then
+            local data, size = eq.bytes(value)
+            port = gate.nil_gate_graph_port_blob(graph, data, size)
+        else
+            port = gate["nil_gate_graph_port_" .. eq.name](graph, eq.write(value))
+        end
+    else
+        local port_info = ffi.new("nil_gate_port_info")
+        local id = nil
 
-    if (value ~= nil) then
-        id = ffi.C.malloc(1)
-        refs[to_ref_id(id)] = { value = value, eq = eq }
-    end
+        if (value ~= nil) then
+            id = ffi.C.malloc(1)
+            refs[to_ref_id(id)] = { value = value, eq = eq }
+        end
 
-    port_info.eq = lua_fns.port_eq
-    port_info.destroy = lua_fns.cleanup
+        port_info.eq = lua_fns.port_eq
+        port_info.destroy = lua_fns.cleanup
+        port = gate.nil_gate_graph_port(graph, port_info, id)
+    end
 
     return {
-        _port = gate.nil_gate_graph_port(graph, port_info, id),
+        _port = port,
         to_direct = function(self)
             local mport = gate.nil_gate_eport_to_direct(self._port)
             return create_mport(refs, gate, mport, eq)
         end,
         as_input = function(self)
-            return create_rport(refs, gate, gate.nil_gate_eport_as_input(self._port))
+            return create_rport(refs, gate, gate.nil_gate_eport_as_input(self._port), is_kind(eq) and eq or nil)
         end
     }
 end
 
 ---@return nil_gate.Node
-local function create_lua_node(refs, lua_fns, gate, graph, fn, inputs, outputs)
+local function create_lua_node(refs, lua_fns, gate, graph, host, fn, inputs, outputs)
     local id = ffi.C.malloc(1)
     local node_info = ffi.new("nil_gate_node_info")
 
     local input_rports = nil
+    local input_kinds = {}
     local port_infos = nil
 
     if (#inputs == 0) then
@@ -269,7 +465,9 @@ local function create_lua_node(refs, lua_fns, gate, graph, fn, inputs, outputs)
     else
         input_rports = ffi.new("nil_gate_rport[?]", #inputs)
         for i, v in ipairs(inputs) do
-            input_rports[i - 1] = v:as_input()._port
+            local rport = v:as_input()
+            input_rports[i - 1] = rport._port
+            input_kinds[i] = rport._kind or false
         end
 
         node_info.inputs.size = #inputs
@@ -282,21 +480,30 @@ local function create_lua_node(refs, lua_fns, gate, graph, fn, inputs, outputs)
     else
         port_infos = ffi.new("nil_gate_port_info[?]", #outputs)
 
-        for i in ipairs(outputs) do
-            port_infos[i - 1].eq = lua_fns.port_eq
-            port_infos[i - 1].destroy = lua_fns.cleanup
+        for i, output in ipairs(outputs) do
+            if is_kind(output) then
+                port_infos[i - 1] = gate.kind_info(output)
+            else
+                port_infos[i - 1].eq = lua_fns.port_eq
+                port_infos[i - 1].destroy = lua_fns.cleanup
+            end
         end
 
         node_info.outputs.size = #outputs
         node_info.outputs.infos = port_infos
     end
 
-    node_info.exec = lua_fns.node_exec
+    -- host-driven cores run the node from their own loop, not through a callback
+    if host then
+        node_info.exec = nil
+    else
+        node_info.exec = lua_fns.node_exec
+    end
     node_info.cleanup = lua_fns.cleanup
     node_info.context = id
     local node = gate.nil_gate_graph_node(graph, node_info)
 
-    refs[to_ref_id(id)] = { fn = fn, outputs = outputs }
+    refs[to_ref_id(id)] = { fn = fn, inputs = input_kinds, outputs = outputs }
 
     return {
         _node = node,
@@ -308,30 +515,34 @@ local function create_lua_node(refs, lua_fns, gate, graph, fn, inputs, outputs)
                 local node_output_rports = ffi.new("nil_gate_rport[?]", output_size)
                 gate.nil_gate_node_outputs(self._node, node_output_rports)
                 for i = 1, output_size, 1 do
-                    output_rports[i] = create_rport(refs, gate, node_output_rports[i - 1])
+                    local kind = is_kind(outputs[i]) and outputs[i] or nil
+                    output_rports[i] = create_rport(refs, gate, node_output_rports[i - 1], kind)
                 end
             end
 
             return output_rports
+        end,
+        set_affinity = function(self, tag)
+            gate.nil_gate_node_set_affinity(self._node, tag)
         end
     }
 end
 
 ---@return nil_gate.Graph
-local function to_lua_graph(refs, lua_fns, gate, graph)
+local function to_lua_graph(refs, lua_fns, gate, graph, host)
     return {
         _graph = graph,
         port = function(self, eq, value)
             return create_lua_eport(refs, lua_fns, gate, self._graph, eq, value)
         end,
         node = function(self, fn, inputs, outputs)
-            return create_lua_node(refs, lua_fns, gate, graph, fn, inputs, outputs)
+            return create_lua_node(refs, lua_fns, gate, graph, host, fn, inputs, outputs)
         end
     }
 end
 
 ---@return nil_gate.Core
-local function to_lua_core(refs, lua_fns, gate, core)
+local function to_lua_core(refs, lua_fns, gate, core, host)
     return {
         _core = core,
         destroy = function(self)
@@ -340,55 +551,117 @@ local function to_lua_core(refs, lua_fns, gate, core)
             end
 
             gate.nil_gate_core_unset_runner(self._core)
+            for _, executor in ipairs(lua_fns.executors) do
+                executor:close()
+            end
             gate.nil_gate_core_destroy(self._core)
         end,
+        -- the nodes with the affinity `tag` are queued by the async runner threads
+        -- and run by the thread calling `run` (the thread owning this Lua state)
+        executor = function(self, tag)
+            local queue = gate.nil_gate_task_queue_create()
+            gate.nil_gate_core_set_executor(self._core, tag, gate.nil_gate_task_queue_executor(queue))
+            local executor = {
+                -- runs the queued nodes, waits up to `timeout_ms` for one. returns how many ran
+                run = function(_, timeout_ms)
+                    if queue == nil then
+                        return 0
+                    end
+                    return tonumber(gate.nil_gate_task_queue_run(queue, timeout_ms or 0))
+                end,
+                close = function(_)
+                    if queue ~= nil then
+                        gate.nil_gate_task_queue_destroy(queue)
+                        queue = nil
+                    end
+                end
+            }
+            lua_fns.executors[#lua_fns.executors + 1] = executor
+            return executor
+        end,
         post = function(self, fn)
-            gate.nil_gate_core_post(self._core, lua_fns.to_core_callable(fn))
+            gate.nil_gate_core_post(self._core, lua_fns.to_core_callable(fn, host))
         end,
         commit = function(self)
             gate.nil_gate_core_commit(self._core)
+            if host then
+                lua_fns.drive(self._core)
+            end
         end,
         apply = function(self, fn)
-            gate.nil_gate_core_apply(self._core, lua_fns.to_core_callable(fn))
+            gate.nil_gate_core_apply(self._core, lua_fns.to_core_callable(fn, host))
+            if host then
+                lua_fns.drive(self._core)
+            end
         end
     }
 end
 
-local function create_core(gate)
+local function create_core(gate, host_driven)
     local refs = {}
     local lua_fns = {}
 
     local post_exec = ffi.cast(
         "void (*)(nil_gate_graph*, void*)",
         function(graph, id)
-            refs[to_ref_id(id)].fn(to_lua_graph(refs, lua_fns, gate, graph[0]))
+            local state = refs[to_ref_id(id)]
+            state.fn(to_lua_graph(refs, lua_fns, gate, graph[0], state.host))
         end
     )
 
+    local function run_node(args, host)
+        local node = refs[to_ref_id(args.context)]
+
+        local inputs = {}
+        for i = 1, args.inputs.size, 1 do
+            inputs[i] = read_value(refs, node.inputs[i] or nil, args.inputs.data[i - 1])
+        end
+
+        local outputs = {}
+        for i = 1, args.outputs.size do
+            local mport = ffi.new("nil_gate_mport")
+            mport.handle = args.outputs.ports[i - 1].handle
+            mport.info = args.outputs.ports[i - 1].info
+            outputs[i] = create_mport(refs, gate, mport, node.outputs[i])
+        end
+        node.fn({
+            core = to_lua_core(refs, lua_fns, gate, args.core, host),
+            inputs = inputs,
+            outputs = outputs
+        })
+    end
+
     local node_exec = ffi.cast(
         "void (*)(const nil_gate_node_args* args)",
         function(args)
-            local inputs = {}
-            for i = 1, args.inputs.size, 1 do
-                inputs[i] = refs[to_ref_id(args.inputs.data[i - 1])].value
-            end
+            run_node(args, false)
+        end
+    )
 
-            local outputs = {}
-            local node = refs[to_ref_id(args.context)]
-            for i = 1, args.outputs.size do
-                local mport = ffi.new("nil_gate_mport")
-                mport.handle = args.outputs.ports[i - 1].handle
-                mport.info = args.outputs.ports[i - 1].info
-                outputs[i] = create_mport(refs, gate, mport, node.outputs[i])
+    -- commits from within host nodes are picked up by the loop that is already running
+    local driving = false
+    local function drive(core)
+        if driving then
+            return
+        end
+        driving = true
+        local ok, err = pcall(function()
+            while true do
+                local batch = gate.nil_gate_core_next(core)
+                if batch.size == 0 then
+                    break
+                end
+                for i = 0, tonumber(batch.size) - 1 do
+                    run_node(batch.args[i], true)
+                end
+                gate.nil_gate_core_done(core)
             end
-            refs[to_ref_id(args.context)]
-                .fn({
-                    core = to_lua_core(refs, lua_fns, gate, args.core),
-                    inputs = inputs,
-                    outputs = outputs
-                })
+        end)
+        driving = false
+        if not ok then
+            error(err, 0)
         end
-    )
+    end
 
     local cleanup = ffi.cast(
         "void (*)(void*)",
@@ -430,7 +703,9 @@ local function create_core(gate)
         node_exec = node_exec,
         port_eq = port_eq,
         cleanup = cleanup,
-        to_core_callable = function (fn)
+        drive = drive,
+        executors = {},
+        to_core_callable = function (fn, host)
             local id = ffi.C.malloc(1)
 
             local callable = ffi.new("nil_gate_core_callable")
@@ -438,27 +713,163 @@ local function create_core(gate)
             callable.cleanup = lua_fns.cleanup
             callable.context = id
 
-            refs[to_ref_id(id)] = { fn = fn }
+            refs[to_ref_id(id)] = { fn = fn, host = host }
             return callable
         end
     }
 
     local core = gate.nil_gate_core_create()
-    gate.nil_gate_core_set_runner_soft_blocking(core)
+    if host_driven then
+        gate.nil_gate_core_set_runner_host(core)
+    else
+        gate.nil_gate_core_set_runner_soft_blocking(core)
+    end
     return to_lua_core(
         refs,
         lua_fns,
         gate,
-        core
+        core,
+        host_driven
     )
 end
 
-local gate = ffi.load(current_file_dir() .. "libgate-c-api.so")
+local lib = ffi.load(current_file_dir() .. "libgate-c-api.so")
 
-return {
-    create_core = function()
-        return create_core(gate)
+-- the library plus the lookups of the built-in kinds
+local gate = setmetatable({ kinds_by_eq = {} }, { __index = lib })
+
+for _, kind in pairs(kinds) do
+    gate.kinds_by_eq[fn_address(lib["nil_gate_port_eq_" .. kind.name])] = kind
+end
+
+gate.kind_info = function(kind)
+    local info = ffi.new("nil_gate_port_info")
+    info.eq = lib["nil_gate_port_eq_" .. kind.name]
+    info.destroy = lib["nil_gate_port_destroy_" .. kind.name]
+    return info
+end
+
+-- batch access: one library call for many ports
+
+---@param ports nil_gate.MPort[]
+---@param values unknown[] nil unsets the port
+local function set_values(ports, values)
+    local count = #ports
+    if count == 0 then
+        return
+    end
+
+    local mports = ffi.new("nil_gate_mport[?]", count)
+    for i = 1, count do
+        mports[i - 1] = ports[i]._port
     end
+
+    -- same scalar kind everywhere: pass the values as a native array
+    local kind = ports[1]._eq
+    local same_scalar = is_kind(kind) and kind.ctype ~= nil
+    for i = 1, count do
+        same_scalar = same_scalar and ports[i]._eq == kind and values[i] ~= nil
+    end
+    if same_scalar then
+        local native = ffi.new(kind.ctype .. "[?]", count)
+        for i = 1, count do
+            native[i - 1] = kind.write(values[i])
+        end
+        gate["nil_gate_mports_set_" .. kind.name](mports, native, count)
+        return
+    end
+
+    local keep = {}
+    local pointers = ffi.new("void*[?]", count)
+    for i = 1, count do
+        local port = ports[i]
+        local value = values[i]
+        if value == nil then
+            pointers[i - 1] = nil
+        elseif is_kind(port._eq) and port._eq.bytes ~= nil then
+            local data, size = port._eq.bytes(value)
+            local blob = ffi.new("nil_gate_blob[1]")
+            blob[0].size = size
+            blob[0].data = data
+            keep[i] = { data, blob }
+            pointers[i - 1] = blob
+        elseif is_kind(port._eq) then
+            local native = ffi.new(port._eq.ctype .. "[1]", port._eq.write(value))
+            keep[i] = native
+            pointers[i - 1] = native
+        else
+            local new_id = ffi.C.malloc(1)
+            port._refs[to_ref_id(new_id)] = { value = value, eq = port._eq }
+            pointers[i - 1] = new_id
+        end
+    end
+    gate.nil_gate_mports_set_values(mports, pointers, count)
+end
+
+local function to_rports(ports)
+    local rports = ffi.new("nil_gate_rport[?]", #ports)
+    for i = 1, #ports do
+        rports[i - 1] = ports[i]._port
+    end
+    return rports
+end
+
+---@param ports nil_gate.RPort[]
+---@return unknown[] values, nil for ports without a value
+local function read_values(ports)
+    local count = #ports
+    local values = {}
+    if count == 0 then
+        return values
+    end
+
+    local pointers = ffi.new("const void*[?]", count)
+    gate.nil_gate_rports_values(to_rports(ports), pointers, count)
+    for i = 1, count do
+        if pointers[i - 1] ~= nil then
+            values[i] = read_value(ports[i]._refs, ports[i]._kind, pointers[i - 1])
+        end
+    end
+    return values
+end
+
+---@param ports nil_gate.RPort[]
+---@return nil_gate.Changes
+local function changes(ports)
+    local count = #ports
+    local rports = to_rports(ports)
+    local versions = ffi.new("uint64_t[?]", count)
+    local changed = ffi.new("uint8_t[?]", count)
+    return {
+        -- indices of the ports that changed since the previous poll (or since creation)
+        poll = function(self)
+            local result = {}
+            if count > 0 and gate.nil_gate_rports_changed(rports, versions, changed, count) > 0 then
+                for i = 1, count do
+                    if changed[i - 1] ~= 0 then
+                        result[#result + 1] = i
+                    end
+                end
+            end
+            return result
+        end
+    }
+end
+
+return {
+    -- host_driven: run the nodes from Lua's own loop instead of native callbacks
+    create_core = function(host_driven)
+        return create_core(gate, host_driven == true)
+    end,
+    set_values = set_values,
+    read_values = read_values,
+    changes = changes,
+    i64 = kinds.i64,
+    f64 = kinds.f64,
+    bool = kinds.bool,
+    blob = kinds.blob,
+    -- kind for values of a fixed-size ffi ctype (struct or array), e.g. cdata("double[3]")
+    cdata = cdata
 }
 
 -- missing
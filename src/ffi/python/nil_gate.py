@@ -1,9 +1,10 @@
 from __future__ import annotations
 
 import ctypes
+import importlib
 from dataclasses import dataclass
 from pathlib import Path
-from typing import Any, Callable, Dict, List, Optional
+from typing import Any, Callable, Dict, List, Optional, Set
 
 TypeEq = Callable[[Any, Any], bool]
 NodeFn = Callable[["NodeArgs"], None]
@@ -109,12 +110,92 @@ class nil_gateNodeInfo(ctypes.Structure):
     ]
 
 
+class nil_gateNodeBatch(ctypes.Structure):
+    _fields_ = [
+        ("size", ctypes.c_size_t),
+        ("args", ctypes.POINTER(ctypes.POINTER(nil_gateNodeArgs))),
+    ]
+
+
 class nil_gateNode(ctypes.Structure):
     _fields_ = [("handle", ctypes.c_void_p)]
 
+
+class nil_gateTask(ctypes.Structure):
+    _fields_ = [("handle", ctypes.c_void_p)]
+
+
+NIL_GATE_TASK_POST = ctypes.CFUNCTYPE(None, nil_gateTask, ctypes.c_void_p)
+
+
+class nil_gateExecutor(ctypes.Structure):
+    _fields_ = [
+        ("post", NIL_GATE_TASK_POST),
+        ("context", ctypes.c_void_p),
+        ("cleanup", NIL_GATE_CLEANUP),
+    ]
+
+
+class nil_gateTaskQueue(ctypes.Structure):
+    _fields_ = [("handle", ctypes.c_void_p)]
+
+
+class nil_gateBlob(ctypes.Structure):
+    _fields_ = [
+        ("size", ctypes.c_size_t),
+        ("data", ctypes.c_void_p),
+    ]
+
 def _to_ref_id(ptr: Any) -> int:
     return int(ctypes.cast(ptr, ctypes.c_void_p).value)
 
+
+class Kind:
+    """Built-in port kind. Values are stored and compared by the library without calling back into Python."""
+    __slots__ = ("name", "_read")
+
+    def __init__(self, name: str, read: Callable[[Any], Any]) -> None:
+        self.name = name
+        self._read = read
+
+    def read(self, ptr: Any) -> Any:
+        return self._read(ptr)
+
+
+def _read_blob(ptr: Any) -> bytes:
+    blob = ctypes.cast(ptr, ctypes.POINTER(nil_gateBlob)).contents
+    return ctypes.string_at(blob.data, blob.size) if blob.size > 0 else b""
+
+
+I64 = Kind("i64", lambda ptr: ctypes.cast(ptr, ctypes.POINTER(ctypes.c_int64)).contents.value)
+F64 = Kind("f64", lambda ptr: ctypes.cast(ptr, ctypes.POINTER(ctypes.c_double)).contents.value)
+BOOL = Kind("bool", lambda ptr: ctypes.cast(ptr, ctypes.POINTER(ctypes.c_int)).contents.value != 0)
+BLOB = Kind("blob", _read_blob)
+# zero-copy buffers need the compiled extension. through ctypes they are copied like BLOB.
+BUFFER = BLOB
+
+TypeKind = TypeEq | Kind
+
+# keyed by the address of the kind's `eq` function in the loaded library
+_KINDS_BY_EQ: Dict[int, Kind] = {}
+
+
+def _kind_of(info: nil_gatePortInfo) -> Optional[Kind]:
+    return _KINDS_BY_EQ.get(ctypes.cast(info.eq, ctypes.c_void_p).value or 0)
+
+
+def _kind_info(gate: Any, kind: Kind) -> nil_gatePortInfo:
+    return nil_gatePortInfo(
+        eq=ctypes.cast(getattr(gate, f"nil_gate_port_eq_{kind.name}"), NIL_GATE_EQ),
+        destroy=ctypes.cast(getattr(gate, f"nil_gate_port_destroy_{kind.name}"), NIL_GATE_CLEANUP),
+    )
+
+
+def _read_value(refs: Dict[int, "RefState"], kind: Optional[Kind], ptr: Any) -> Any:
+    if kind is not None:
+        return kind.read(ptr)
+    return refs[_to_ref_id(ptr)].value
+
 @dataclass
 class _PortState:
     __slots__ = ("value", "eq")
@@ -123,25 +204,30 @@ class _PortState:
 
 @dataclass
 class _NodeState:
-    __slots__ = ("fn", "outputs")
+    __slots__ = ("fn", "inputs", "outputs")
     fn: NodeFn
-    outputs: List[TypeEq]
+    inputs: List[Optional[Kind]]
+    outputs: List[TypeKind]
 
 @dataclass
 class _CallableState:
-    __slots__ = ("fn")
+    __slots__ = ("fn", "host")
     fn: PostFn
+    host: bool
 
 RefState = _PortState | _NodeState | _CallableState
 
 @dataclass
 class _FnsState:
-    __slots__ = ("post_exec", "node_exec", "port_eq", "cleanup", "to_core_callable")
+    __slots__ = ("post_exec", "node_exec", "port_eq", "cleanup", "to_core_callable", "drive", "executors")
     post_exec: Any
     node_exec: Any
     port_eq: Any
     cleanup: Any
     to_core_callable: Any
+    drive: Any
+    # executors created per core, closed when the core is destroyed
+    executors: Dict[int, List["Executor"]]
 
 
 @dataclass
@@ -174,6 +260,33 @@ def _configure_signatures(gate: Any) -> None:
     gate.nil_gate_core_unset_runner.argtypes = [nil_gateCore]
     gate.nil_gate_core_unset_runner.restype = None
 
+    gate.nil_gate_core_set_runner_host.argtypes = [nil_gateCore]
+    gate.nil_gate_core_set_runner_host.restype = None
+
+    gate.nil_gate_core_set_executor.argtypes = [nil_gateCore, ctypes.c_uint32, nil_gateExecutor]
+    gate.nil_gate_core_set_executor.restype = None
+
+    gate.nil_gate_task_run.argtypes = [nil_gateTask]
+    gate.nil_gate_task_run.restype = None
+
+    gate.nil_gate_task_queue_create.argtypes = []
+    gate.nil_gate_task_queue_create.restype = nil_gateTaskQueue
+
+    gate.nil_gate_task_queue_destroy.argtypes = [nil_gateTaskQueue]
+    gate.nil_gate_task_queue_destroy.restype = None
+
+    gate.nil_gate_task_queue_executor.argtypes = [nil_gateTaskQueue]
+    gate.nil_gate_task_queue_executor.restype = nil_gateExecutor
+
+    gate.nil_gate_task_queue_run.argtypes = [nil_gateTaskQueue, ctypes.c_uint32]
+    gate.nil_gate_task_queue_run.restype = ctypes.c_size_t
+
+    gate.nil_gate_core_next.argtypes = [nil_gateCore]
+    gate.nil_gate_core_next.restype = nil_gateNodeBatch
+
+    gate.nil_gate_core_done.argtypes = [nil_gateCore]
+    gate.nil_gate_core_done.restype = None
+
     gate.nil_gate_core_post.argtypes = [nil_gateCore, nil_gateCoreCallable]
     gate.nil_gate_core_post.restype = None
 
@@ -192,6 +305,9 @@ def _configure_signatures(gate: Any) -> None:
     gate.nil_gate_node_outputs.argtypes = [nil_gateNode, ctypes.POINTER(nil_gateRPort)]
     gate.nil_gate_node_outputs.restype = None
 
+    gate.nil_gate_node_set_affinity.argtypes = [nil_gateNode, ctypes.c_uint32]
+    gate.nil_gate_node_set_affinity.restype = None
+
     gate.nil_gate_rport_value.argtypes = [nil_gateRPort]
     gate.nil_gate_rport_value.restype = ctypes.c_void_p
 
@@ -216,6 +332,48 @@ def _configure_signatures(gate: Any) -> None:
     gate.nil_gate_eport_to_direct.argtypes = [nil_gateEPort]
     gate.nil_gate_eport_to_direct.restype = nil_gateMPort
 
+    for name, ctype in (("i64", ctypes.c_int64), ("f64", ctypes.c_double), ("bool", ctypes.c_int)):
+        graph_port = getattr(gate, f"nil_gate_graph_port_{name}")
+        graph_port.argtypes = [nil_gateGraph, ctype]
+        graph_port.restype = nil_gateEPort
+
+        mport_set = getattr(gate, f"nil_gate_mport_set_{name}")
+        mport_set.argtypes = [nil_gateMPort, ctype]
+        mport_set.restype = None
+
+    gate.nil_gate_graph_port_blob.argtypes = [nil_gateGraph, ctypes.c_char_p, ctypes.c_size_t]
+    gate.nil_gate_graph_port_blob.restype = nil_gateEPort
+
+    gate.nil_gate_mport_set_blob.argtypes = [nil_gateMPort, ctypes.c_char_p, ctypes.c_size_t]
+    gate.nil_gate_mport_set_blob.restype = None
+
+    gate.nil_gate_mports_set_values.argtypes = [
+        ctypes.POINTER(nil_gateMPort), ctypes.POINTER(ctypes.c_void_p), ctypes.c_size_t
+    ]
+    gate.nil_gate_mports_set_values.restype = None
+
+    for kind, ctype in ((I64, ctypes.c_int64), (F64, ctypes.c_double), (BOOL, ctypes.c_int)):
+        mports_set = getattr(gate, f"nil_gate_mports_set_{kind.name}")
+        mports_set.argtypes = [ctypes.POINTER(nil_gateMPort), ctypes.POINTER(ctype), ctypes.c_size_t]
+        mports_set.restype = None
+
+    gate.nil_gate_rports_values.argtypes = [
+        ctypes.POINTER(nil_gateRPort), ctypes.POINTER(ctypes.c_void_p), ctypes.c_size_t
+    ]
+    gate.nil_gate_rports_values.restype = None
+
+    gate.nil_gate_rports_changed.argtypes = [
+        ctypes.POINTER(nil_gateRPort),
+        ctypes.POINTER(ctypes.c_uint64),
+        ctypes.POINTER(ctypes.c_uint8),
+        ctypes.c_size_t,
+    ]
+    gate.nil_gate_rports_changed.restype = ctypes.c_size_t
+
+    for kind in (I64, F64, BOOL, BLOB):
+        eq = getattr(gate, f"nil_gate_port_eq_{kind.name}")
+        _KINDS_BY_EQ[ctypes.cast(eq, ctypes.c_void_p).value] = kind
+
 
 class RPort:
     __slots__ = ("_refs", "_gate", "_port")
@@ -227,7 +385,7 @@ class RPort:
 
     def value(self) -> Any:
         rid = self._gate.nil_gate_rport_value(self._port)
-        return self._refs[_to_ref_id(rid)].value
+        return _read_value(self._refs, _kind_of(self._port.info), rid)
 
     def has_value(self) -> bool:
         return self._gate.nil_gate_rport_has_value(self._port) != 0
@@ -239,7 +397,7 @@ class RPort:
 class MPort:
     __slots__ = ("_refs", "_gate", "_libc", "_eq", "_port")
 
-    def __init__(self, refs: Dict[int, RefState], gate: Any, libc: Any, mport: nil_gateMPort, eq: TypeEq) -> None:
+    def __init__(self, refs: Dict[int, RefState], gate: Any, libc: Any, mport: nil_gateMPort, eq: TypeKind) -> None:
         self._refs = refs
         self._gate = gate
         self._libc = libc
@@ -249,13 +407,21 @@ class MPort:
     def value(self) -> Any:
         rport = self._gate.nil_gate_mport_as_input(self._port)
         rid = self._gate.nil_gate_rport_value(rport)
-        return self._refs[_to_ref_id(rid)].value
+        return _read_value(self._refs, self._eq if isinstance(self._eq, Kind) else None, rid)
 
     def has_value(self) -> bool:
         rport = self._gate.nil_gate_mport_as_input(self._port)
         return self._gate.nil_gate_rport_has_value(rport) != 0
 
     def set_value(self, new_value: Any) -> None:
+        if self._eq is BLOB:
+            data = bytes(new_value)
+            self._gate.nil_gate_mport_set_blob(self._port, data, len(data))
+            return
+        if isinstance(self._eq, Kind):
+            getattr(self._gate, f"nil_gate_mport_set_{self._eq.name}")(self._port, new_value)
+            return
+
         new_id = self._libc.malloc(1)
         if not new_id:
             raise MemoryError("malloc failed")
@@ -272,7 +438,7 @@ class MPort:
 class EPort:
     __slots__ = ("_refs", "_gate", "_libc", "_eq", "_port")
 
-    def __init__(self, refs: Dict[int, RefState], gate: Any, libc: Any, eport: nil_gateEPort, eq: TypeEq) -> None:
+    def __init__(self, refs: Dict[int, RefState], gate: Any, libc: Any, eport: nil_gateEPort, eq: TypeKind) -> None:
         self._refs = refs
         self._gate = gate
         self._libc = libc
@@ -305,18 +471,138 @@ class Node:
                 out.append(RPort(self._refs, self._gate, rports[i]))
         return out
 
+    def set_affinity(self, tag: int) -> None:
+        """Runs the node through the executor of `tag` (see `Core.executor`), 0 for any thread."""
+        self._gate.nil_gate_node_set_affinity(self._node, tag)
+
+
+class Executor:
+    """Queue of the nodes of one affinity tag, run by the thread calling `run`."""
+    __slots__ = ("_gate", "_queue")
+
+    def __init__(self, gate: Any, queue: nil_gateTaskQueue) -> None:
+        self._gate = gate
+        self._queue = queue
+
+    def run(self, timeout: float = 0.0) -> int:
+        """Runs the queued nodes, waiting up to `timeout` seconds when there is none. Returns how many ran."""
+        if not self._queue.handle:
+            return 0
+        return int(self._gate.nil_gate_task_queue_run(self._queue, int(timeout * 1000)))
+
+    def _close(self) -> None:
+        if self._queue.handle:
+            self._gate.nil_gate_task_queue_destroy(self._queue)
+            self._queue = nil_gateTaskQueue()
+
+
+_SCALAR_CTYPES: Dict[str, Any] = {"i64": ctypes.c_int64, "f64": ctypes.c_double, "bool": ctypes.c_int}
+
+
+def set_values(ports: List[MPort], values: List[Any]) -> None:
+    """Set many ports with a single library call. `None` unsets the port."""
+    if len(ports) != len(values):
+        raise ValueError("ports and values must have the same length")
+    if not ports:
+        return
+
+    gate = ports[0]._gate
+    mports = (nil_gateMPort * len(ports))(*(p._port for p in ports))
+
+    # same scalar kind everywhere: pass the values as a native array
+    kind = ports[0]._eq
+    if (
+        isinstance(kind, Kind)
+        and kind.name in _SCALAR_CTYPES
+        and all(p._eq is kind for p in ports)
+        and all(v is not None for v in values)
+    ):
+        native = (_SCALAR_CTYPES[kind.name] * len(values))(*values)
+        getattr(gate, f"nil_gate_mports_set_{kind.name}")(mports, native, len(ports))
+        return
+
+    keep: List[Any] = []
+    pointers = (ctypes.c_void_p * len(ports))()
+    for i, (port, value) in enumerate(zip(ports, values)):
+        if value is None:
+            continue
+        if port._eq is BLOB:
+            data = bytes(value)
+            blob = nil_gateBlob(size=len(data), data=ctypes.cast(ctypes.c_char_p(data), ctypes.c_void_p))
+            keep.append((data, blob))
+            pointers[i] = ctypes.cast(ctypes.pointer(blob), ctypes.c_void_p)
+        elif isinstance(port._eq, Kind):
+            native = _SCALAR_CTYPES[port._eq.name](value)
+            keep.append(native)
+            pointers[i] = ctypes.cast(ctypes.pointer(native), ctypes.c_void_p)
+        else:
+            new_id = port._libc.malloc(1)
+            if not new_id:
+                raise MemoryError("malloc failed")
+            port._refs[_to_ref_id(new_id)] = _PortState(value=value, eq=port._eq)
+            pointers[i] = new_id
+    gate.nil_gate_mports_set_values(mports, pointers, len(ports))
+
+
+def read_values(ports: List[RPort]) -> List[Any]:
+    """Read many ports with a single library call. `None` for ports without a value."""
+    if not ports:
+        return []
+
+    gate = ports[0]._gate
+    rports = (nil_gateRPort * len(ports))(*(p._port for p in ports))
+    pointers = (ctypes.c_void_p * len(ports))()
+    gate.nil_gate_rports_values(rports, pointers, len(ports))
+    return [
+        None if not ptr else _read_value(port._refs, _kind_of(port._port.info), ptr)
+        for port, ptr in zip(ports, pointers)
+    ]
+
+
+class Changes:
+    """Tracks which of the given ports changed between calls to `poll`."""
+    __slots__ = ("_gate", "_ports", "_versions", "_changed")
+
+    def __init__(self, ports: List[RPort]) -> None:
+        self._gate = ports[0]._gate if ports else None
+        self._ports = (nil_gateRPort * len(ports))(*(p._port for p in ports))
+        self._versions = (ctypes.c_uint64 * len(ports))()
+        self._changed = (ctypes.c_uint8 * len(ports))()
+
+    def poll(self) -> List[int]:
+        """Indices of the ports that changed since the previous poll (or since creation)."""
+        if self._gate is None:
+            return []
+        count = len(self._ports)
+        if self._gate.nil_gate_rports_changed(self._ports, self._versions, self._changed, count) == 0:
+            return []
+        return [i for i in range(count) if self._changed[i]]
+
 
 class Graph:
-    __slots__ = ("_refs", "_fns", "_gate", "_libc", "_graph")
+    __slots__ = ("_refs", "_fns", "_gate", "_libc", "_graph", "_host")
 
-    def __init__(self, refs: Dict[int, RefState], fns: _FnsState, gate: Any, libc: Any, graph: nil_gateGraph) -> None:
+    def __init__(
+        self, refs: Dict[int, RefState], fns: _FnsState, gate: Any, libc: Any, graph: nil_gateGraph, host: bool = False
+    ) -> None:
         self._refs = refs
         self._fns = fns
         self._gate = gate
         self._libc = libc
         self._graph = graph
+        self._host = host
+
+    def port(self, eq: TypeKind, value: Optional[Any] = None) -> EPort:
+        if isinstance(eq, Kind):
+            if value is None:
+                handle = self._gate.nil_gate_graph_port(self._graph, _kind_info(self._gate, eq), None)
+            elif eq is BLOB:
+                data = bytes(value)
+                handle = self._gate.nil_gate_graph_port_blob(self._graph, data, len(data))
+            else:
+                handle = getattr(self._gate, f"nil_gate_graph_port_{eq.name}")(self._graph, value)
+            return EPort(self._refs, self._gate, self._libc, handle, eq)
 
-    def port(self, eq: TypeEq, value: Optional[Any] = None) -> EPort:
         ptr = ctypes.c_void_p()
         if value is not None:
             allocated = self._libc.malloc(1)
@@ -329,7 +615,7 @@ class Graph:
         handle = self._gate.nil_gate_graph_port(self._graph, port_info, ptr)
         return EPort(self._refs, self._gate, self._libc, handle, eq)
 
-    def node(self, fn: NodeFn, inputs: List[Any], outputs: List[TypeEq]) -> Node:
+    def node(self, fn: NodeFn, inputs: List[Any], outputs: List[TypeKind]) -> Node:
         ctx_id = self._libc.malloc(1)
         if not ctx_id:
             raise MemoryError("malloc failed")
@@ -348,13 +634,17 @@ class Graph:
             c_outputs = nil_gatePortInfos(size=0, infos=None)
         else:
             output_infos = (nil_gatePortInfo * len(outputs))()
-            for i in range(len(outputs)):
-                output_infos[i].eq = self._fns.port_eq
-                output_infos[i].destroy = self._fns.cleanup
+            for i, output in enumerate(outputs):
+                if isinstance(output, Kind):
+                    output_infos[i] = _kind_info(self._gate, output)
+                else:
+                    output_infos[i].eq = self._fns.port_eq
+                    output_infos[i].destroy = self._fns.cleanup
             c_outputs = nil_gatePortInfos(size=len(outputs), infos=output_infos)
 
+        # host-driven cores run the node from their own loop, not through a callback
         node_info = nil_gateNodeInfo(
-            exec=self._fns.node_exec,
+            exec=NIL_GATE_NODE_EXEC() if self._host else self._fns.node_exec,
             inputs=c_inputs,
             outputs=c_outputs,
             context=ctypes.c_void_p(ctx_id),
@@ -364,34 +654,52 @@ class Graph:
         node = self._gate.nil_gate_graph_node(self._graph, node_info)
         self._refs[_to_ref_id(ctx_id)] = _NodeState(
             fn=fn,
+            inputs=[_kind_of(input_rports[i].info) for i in range(len(inputs))],
             outputs=outputs
         )
         return Node(self._refs, self._gate, node)
 
 
 class Core:
-    __slots__ = ("_refs", "_fns", "_gate", "_libc", "_core")
+    __slots__ = ("_refs", "_fns", "_gate", "_libc", "_core", "_host")
 
-    def __init__(self, refs: Dict[int, RefState], fns: _FnsState, gate: Any, libc: Any, core: nil_gateCore) -> None:
+    def __init__(
+        self, refs: Dict[int, RefState], fns: _FnsState, gate: Any, libc: Any, core: nil_gateCore, host: bool = False
+    ) -> None:
         self._refs = refs
         self._fns = fns
         self._gate = gate
         self._libc = libc
         self._core = core
+        self._host = host
 
     def destroy(self) -> None:
         self._refs.clear()
         self._gate.nil_gate_core_unset_runner(self._core)
+        for executor in self._fns.executors.pop(int(self._core.handle or 0), []):
+            executor._close()
         self._gate.nil_gate_core_destroy(self._core)
 
+    def executor(self, tag: int) -> Executor:
+        """Hands the nodes with the affinity `tag` to the thread calling `Executor.run` (async runner)."""
+        queue = self._gate.nil_gate_task_queue_create()
+        self._gate.nil_gate_core_set_executor(self._core, tag, self._gate.nil_gate_task_queue_executor(queue))
+        executor = Executor(self._gate, queue)
+        self._fns.executors.setdefault(int(self._core.handle or 0), []).append(executor)
+        return executor
+
     def post(self, fn: PostFn) -> None:
-        self._gate.nil_gate_core_post(self._core, self._fns.to_core_callable(fn))
+        self._gate.nil_gate_core_post(self._core, self._fns.to_core_callable(fn, self._host))
 
     def apply(self, fn: PostFn) -> None:
-        self._gate.nil_gate_core_apply(self._core, self._fns.to_core_callable(fn))
+        self._gate.nil_gate_core_apply(self._core, self._fns.to_core_callable(fn, self._host))
+        if self._host:
+            self._fns.drive(self)
 
     def commit(self) -> None:
         self._gate.nil_gate_core_commit(self._core)
+        if self._host:
+            self._fns.drive(self)
 
 
 class Gate:
@@ -411,18 +719,18 @@ class Gate:
         @NIL_GATE_CORE_CALLABLE_EXEC
         def post_exec(graph_ptr: Any, ptr: Any) -> None:
             graph = graph_ptr.contents
-            node = self._refs[_to_ref_id(ptr)]
-            node.fn(Graph(self._refs, self._fns, self._gate, self._libc, graph))
+            state = self._refs[_to_ref_id(ptr)]
+            state.fn(Graph(self._refs, self._fns, self._gate, self._libc, graph, state.host))
 
-        @NIL_GATE_NODE_EXEC
-        def node_exec(args_ptr: Any) -> None:
+        def run_node(args_ptr: Any, host: bool) -> None:
             args = args_ptr.contents
 
+            node = self._refs[_to_ref_id(args.context)]
+
             in_values: List[Any] = []
             for i in range(int(args.inputs.size)):
-                in_values.append(self._refs[_to_ref_id(args.inputs.data[i])].value)
+                in_values.append(_read_value(self._refs, node.inputs[i], args.inputs.data[i]))
 
-            node = self._refs[_to_ref_id(args.context)]
             out_ports: List[MPort] = []
             for i in range(int(args.outputs.size)):
                 out_ports.append(
@@ -431,12 +739,35 @@ class Gate:
 
             node.fn(
                 NodeArgs(
-                    core=Core(self._refs, self._fns, self._gate, self._libc, args.core),
+                    core=Core(self._refs, self._fns, self._gate, self._libc, args.core, host),
                     inputs=in_values,
                     outputs=out_ports,
                 )
             )
 
+        @NIL_GATE_NODE_EXEC
+        def node_exec(args_ptr: Any) -> None:
+            run_node(args_ptr, False)
+
+        # cores currently inside `drive`. commits from within host nodes are picked up by the same loop.
+        driving: Set[int] = set()
+
+        def drive(core: "Core") -> None:
+            key = int(core._core.handle or 0)
+            if key in driving:
+                return
+            driving.add(key)
+            try:
+                while True:
+                    batch = self._gate.nil_gate_core_next(core._core)
+                    if batch.size == 0:
+                        break
+                    for i in range(int(batch.size)):
+                        run_node(batch.args[i], True)
+                    self._gate.nil_gate_core_done(core._core)
+            finally:
+                driving.discard(key)
+
         @NIL_GATE_CLEANUP
         def cleanup(ptr: Any) -> None:
             if ptr:
@@ -458,7 +789,7 @@ class Gate:
 
             return 1 if l_value.eq(l_value.value, r_value.value) else 0
 
-        def to_core_callable(fn: PostFn) -> nil_gateCoreCallable:
+        def to_core_callable(fn: PostFn, host: bool = False) -> nil_gateCoreCallable:
             ctx_id = self._libc.malloc(1)
             if not ctx_id:
                 raise MemoryError("malloc failed")
@@ -469,7 +800,7 @@ class Gate:
                 cleanup=self._fns.cleanup,
             )
 
-            self._refs[_to_ref_id(ctx_id)] = _CallableState(fn=fn)
+            self._refs[_to_ref_id(ctx_id)] = _CallableState(fn=fn, host=host)
             return callable_value
 
         self._fns = _FnsState(
@@ -477,13 +808,25 @@ class Gate:
             node_exec=node_exec,
             port_eq=port_eq,
             cleanup=cleanup,
-            to_core_callable=to_core_callable
+            to_core_callable=to_core_callable,
+            drive=drive,
+            executors={},
         )
 
-    def create_core(self) -> Core:
+    def create_core(self, host_driven: bool = False, threads: int = 0) -> Core:
+        """`host_driven` runs the nodes from Python's own loop instead of native callbacks.
+        `threads` > 0 runs them on an async runner with that many threads (see `Core.executor`).
+        """
+        if host_driven and threads > 0:
+            raise ValueError("host_driven and threads are exclusive")
         core = self._gate.nil_gate_core_create()
-        self._gate.nil_gate_core_set_runner_soft_blocking(core)
-        return Core(self._refs, self._fns, self._gate, self._libc, core)
+        if host_driven:
+            self._gate.nil_gate_core_set_runner_host(core)
+        elif threads > 0:
+            self._gate.nil_gate_core_set_runner_async(core, threads)
+        else:
+            self._gate.nil_gate_core_set_runner_soft_blocking(core)
+        return Core(self._refs, self._fns, self._gate, self._libc, core, host_driven)
 
 
 def _load_gate_from_module_dir() -> Gate:
@@ -496,8 +839,42 @@ def _load_gate_from_module_dir() -> Gate:
 _GATE = _load_gate_from_module_dir()
 
 
-def create_core() -> Core:
-    return _GATE.create_core()
-
-
-__all__ = ["create_core", "Gate", "Core", "Graph", "Node", "NodeArgs", "EPort", "MPort", "RPort"]
+def create_core(host_driven: bool = False, threads: int = 0) -> Core:
+    return _GATE.create_core(host_driven, threads)
+
+
+__all__ = [
+    "create_core",
+    "Gate",
+    "Core",
+    "Graph",
+    "Node",
+    "Executor",
+    "NodeArgs",
+    "EPort",
+    "MPort",
+    "RPort",
+    "Kind",
+    "I64",
+    "F64",
+    "BOOL",
+    "BLOB",
+    "BUFFER",
+    "set_values",
+    "read_values",
+    "Changes",
+]
+
+
+# the compiled extension (same API, no ctypes marshaling) replaces this implementation when available
+def _load_extension() -> Any:
+    name = f"{__package__}.nil_gate_ext" if __package__ else "nil_gate_ext"
+    try:
+        return importlib.import_module(name)
+    except ImportError:
+        return None
+
+
+_EXT = _load_extension()
+if _EXT is not None:
+    globals().update({name: getattr(_EXT, name) for name in __all__})
@@ -7,6 +7,21 @@ NodeFn = Callable[[NodeArgs], None]
 PostFn = Callable[[Graph], None]
 
 
+class Kind:
+    name: str
+    def __init__(self, name: str, read: Callable[[Any], Any]) -> None: ...
+    def read(self, ptr: Any) -> Any: ...
+
+
+I64: Kind
+F64: Kind
+BOOL: Kind
+BLOB: Kind
+BUFFER: Kind
+
+TypeKind = TypeEq | Kind
+
+
 class RPort:
     def __init__(self, refs: Dict[int, Any], gate: Any, rport: Any) -> None: ...
     def value(self) -> Any: ...
@@ -15,7 +30,7 @@ class RPort:
 
 
 class MPort:
-    def __init__(self, refs: Dict[int, Any], gate: Any, libc: Any, mport: Any, eq: TypeEq) -> None: ...
+    def __init__(self, refs: Dict[int, Any], gate: Any, libc: Any, mport: Any, eq: TypeKind) -> None: ...
     def value(self) -> Any: ...
     def has_value(self) -> bool: ...
     def set_value(self, new_value: Any) -> None: ...
@@ -24,7 +39,7 @@ class MPort:
 
 
 class EPort:
-    def __init__(self, refs: Dict[int, Any], gate: Any, libc: Any, eport: Any, eq: TypeEq) -> None: ...
+    def __init__(self, refs: Dict[int, Any], gate: Any, libc: Any, eport: Any, eq: TypeKind) -> None: ...
     def to_direct(self) -> MPort: ...
     def as_input(self) -> RPort: ...
 
@@ -32,25 +47,31 @@ class EPort:
 class Node:
     def __init__(self, refs: Dict[int, Any], gate: Any, node: Any) -> None: ...
     def outputs(self) -> List[RPort]: ...
+    def set_affinity(self, tag: int) -> None: ...
+
+
+class Executor:
+    def run(self, timeout: float = 0.0) -> int: ...
 
 
 class Graph:
-    def __init__(self, refs: Dict[int, Any], fns: Any, gate: Any, libc: Any, graph: Any) -> None: ...
-    def port(self, eq: TypeEq, value: Optional[Any] = None) -> EPort: ...
-    def node(self, fn: NodeFn, inputs: List[Any], outputs: List[TypeEq]) -> Node: ...
+    def __init__(self, refs: Dict[int, Any], fns: Any, gate: Any, libc: Any, graph: Any, host: bool = False) -> None: ...
+    def port(self, eq: TypeKind, value: Optional[Any] = None) -> EPort: ...
+    def node(self, fn: NodeFn, inputs: List[Any], outputs: List[TypeKind]) -> Node: ...
 
 
 class Core:
-    def __init__(self, refs: Dict[int, Any], fns: Any, gate: Any, libc: Any, core: Any) -> None: ...
+    def __init__(self, refs: Dict[int, Any], fns: Any, gate: Any, libc: Any, core: Any, host: bool = False) -> None: ...
     def destroy(self) -> None: ...
     def post(self, fn: PostFn) -> None: ...
     def apply(self, fn: PostFn) -> None: ...
     def commit(self) -> None: ...
+    def executor(self, tag: int) -> Executor: ...
 
 
 class Gate:
     def __init__(self, gate: Any) -> None: ...
-    def create_core(self) -> Core: ...
+    def create_core(self, host_driven: bool = False, threads: int = 0) -> Core: ...
 
 
 class NodeArgs:
@@ -60,7 +81,16 @@ class NodeArgs:
     def __init__(self, core: Core, inputs: List[Any], outputs: List[MPort]) -> None: ...
 
 
-def create_core() -> Core: ...
+def set_values(ports: List[MPort], values: List[Any]) -> None: ...
+def read_values(ports: List[RPort]) -> List[Any]: ...
+
+
+class Changes:
+    def __init__(self, ports: List[RPort]) -> None: ...
+    def poll(self) -> List[int]: ...
+
+
+def create_core(host_driven: bool = False, threads: int = 0) -> Core: ...
 
 
 __all__: List[str]
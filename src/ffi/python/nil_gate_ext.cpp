@@ -0,0 +1,1799 @@
+// Native CPython binding of the C API. Same Python API as nil_gate.pyi.
+//  - values of custom ports are stored as Python objects (no id registry).
+//  - node, post, eq and cleanup callbacks call straight into Python (no ctypes marshaling).
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <nil/gate.h>
+
+#include <array>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    // GIL guard for the callbacks coming from the library
+    struct GIL
+    {
+        GIL()
+            : state(PyGILState_Ensure())
+        {
+        }
+
+        ~GIL() noexcept
+        {
+            PyGILState_Release(state);
+        }
+
+        GIL(GIL&&) = delete;
+        GIL(const GIL&) = delete;
+        GIL& operator=(GIL&&) = delete;
+        GIL& operator=(const GIL&) = delete;
+
+    private:
+        PyGILState_STATE state;
+    };
+
+    // value of a custom port
+    struct Value
+    {
+        PyObject* object;
+        PyObject* eq;
+    };
+
+    int value_eq(const void* l, const void* r)
+    {
+        if (l == nullptr || r == nullptr)
+        {
+            return l == r ? 1 : 0;
+        }
+
+        const auto* lv = static_cast<const Value*>(l);
+        const auto* rv = static_cast<const Value*>(r);
+        if (lv->eq != rv->eq)
+        {
+            return 0;
+        }
+
+        const GIL gil;
+        PyObject* args[] = {lv->object, rv->object};
+        PyObject* result = PyObject_Vectorcall(lv->eq, args, 2, nullptr);
+        if (result == nullptr)
+        {
+            PyErr_WriteUnraisable(lv->eq);
+            return 0;
+        }
+        const auto is_eq = PyObject_IsTrue(result);
+        Py_DECREF(result);
+        if (is_eq < 0)
+        {
+            PyErr_WriteUnraisable(lv->eq);
+            return 0;
+        }
+        return is_eq;
+    }
+
+    void value_destroy(void* value)
+    {
+        if (value == nullptr)
+        {
+            return;
+        }
+        auto* v = static_cast<Value*>(value);
+        {
+            const GIL gil;
+            Py_DECREF(v->object);
+            Py_DECREF(v->eq);
+        }
+        delete v; // NOLINT
+    }
+
+    constexpr nil_gate_port_info value_info = {.eq = &value_eq, .destroy = &value_destroy};
+
+    Value* make_value(PyObject* object, PyObject* eq)
+    {
+        Py_INCREF(object);
+        Py_INCREF(eq);
+        return new Value{.object = object, .eq = eq}; // NOLINT
+    }
+
+    // built-in kinds
+    enum class EKind
+    {
+        I64,
+        F64,
+        Bool,
+        Blob,
+        // blob that borrows the buffer of the object instead of copying it
+        Buffer
+    };
+
+    struct Kind
+    {
+        PyObject_HEAD
+        EKind kind;
+        PyObject* name;
+    };
+
+    PyTypeObject* kind_type = nullptr;
+    PyObject* kinds[5] = {}; // NOLINT
+
+    nil_gate_port_info kind_info(EKind kind)
+    {
+        switch (kind)
+        {
+            case EKind::I64:
+                return {.eq = &nil_gate_port_eq_i64, .destroy = &nil_gate_port_destroy_i64};
+            case EKind::F64:
+                return {.eq = &nil_gate_port_eq_f64, .destroy = &nil_gate_port_destroy_f64};
+            case EKind::Bool:
+                return {.eq = &nil_gate_port_eq_bool, .destroy = &nil_gate_port_destroy_bool};
+            case EKind::Blob:
+            case EKind::Buffer:
+            default:
+                return {.eq = &nil_gate_port_eq_blob, .destroy = &nil_gate_port_destroy_blob};
+        }
+    }
+
+    // owner of a borrowed buffer. called by the library once the value is dropped.
+    void release_buffer(void* owner)
+    {
+        auto* view = static_cast<Py_buffer*>(owner);
+        {
+            const GIL gil;
+            PyBuffer_Release(view);
+        }
+        delete view; // NOLINT
+    }
+
+    // returns nullptr with a python exception set
+    Py_buffer* borrow_buffer(PyObject* value)
+    {
+        auto* view = new Py_buffer(); // NOLINT
+        if (PyObject_GetBuffer(value, view, PyBUF_ANY_CONTIGUOUS) < 0)
+        {
+            delete view; // NOLINT
+            return nullptr;
+        }
+        return view;
+    }
+
+    Kind* as_kind(PyObject* type_kind)
+    {
+        return Py_IS_TYPE(type_kind, kind_type) ? reinterpret_cast<Kind*>(type_kind) : nullptr;
+    }
+
+    nil_gate_port_info info_of(PyObject* type_kind)
+    {
+        if (const auto* kind = as_kind(type_kind))
+        {
+            return kind_info(kind->kind);
+        }
+        return value_info;
+    }
+
+    // converts a value read from a port of the given info. ptr can not be null.
+    PyObject* read_value(const nil_gate_port_info& info, const void* ptr)
+    {
+        if (info.eq == &value_eq)
+        {
+            auto* object = static_cast<const Value*>(ptr)->object;
+            Py_INCREF(object);
+            return object;
+        }
+        if (info.eq == &nil_gate_port_eq_i64)
+        {
+            return PyLong_FromLongLong(*static_cast<const std::int64_t*>(ptr));
+        }
+        if (info.eq == &nil_gate_port_eq_f64)
+        {
+            return PyFloat_FromDouble(*static_cast<const double*>(ptr));
+        }
+        if (info.eq == &nil_gate_port_eq_bool)
+        {
+            return PyBool_FromLong(*static_cast<const int*>(ptr));
+        }
+        if (info.eq == &nil_gate_port_eq_blob)
+        {
+            const auto* blob = static_cast<const nil_gate_blob*>(ptr);
+            // borrowed buffers are read back as the object that exported them
+            if (auto* view = static_cast<Py_buffer*>(nil_gate_blob_owner(blob, &release_buffer)))
+            {
+                Py_INCREF(view->obj);
+                return view->obj;
+            }
+            return PyBytes_FromStringAndSize(
+                static_cast<const char*>(blob->data),
+                static_cast<Py_ssize_t>(blob->size)
+            );
+        }
+        // port created by another binding
+        return PyLong_FromVoidPtr(const_cast<void*>(ptr)); // NOLINT
+    }
+
+    PyObject* read_port(nil_gate_rport port)
+    {
+        if (nil_gate_rport_has_value(port) == 0)
+        {
+            Py_RETURN_NONE;
+        }
+        return read_value(port.info, nil_gate_rport_value(port));
+    }
+
+    // holds a native copy of a value of a built-in kind, for the calls that take a pointer
+    union Scalar
+    {
+        std::int64_t i64;
+        double f64;
+        int boolean;
+    };
+
+    // returns 0 on success, -1 with a python exception set
+    int to_scalar(EKind kind, PyObject* value, Scalar& scalar)
+    {
+        switch (kind)
+        {
+            case EKind::I64:
+                scalar.i64 = PyLong_AsLongLong(value);
+                break;
+            case EKind::F64:
+                scalar.f64 = PyFloat_AsDouble(value);
+                break;
+            case EKind::Bool:
+            {
+                const auto truth = PyObject_IsTrue(value);
+                if (truth < 0)
+                {
+                    return -1;
+                }
+                scalar.boolean = truth;
+                break;
+            }
+            case EKind::Blob:
+            case EKind::Buffer:
+            default:
+                break;
+        }
+        return PyErr_Occurred() != nullptr ? -1 : 0;
+    }
+
+    int set_port(nil_gate_mport port, PyObject* type_kind, PyObject* value)
+    {
+        const auto* kind = as_kind(type_kind);
+        if (kind == nullptr)
+        {
+            nil_gate_mport_set_value(port, make_value(value, type_kind));
+            return 0;
+        }
+
+        if (kind->kind == EKind::Blob)
+        {
+            Py_buffer view;
+            if (PyObject_GetBuffer(value, &view, PyBUF_SIMPLE) < 0)
+            {
+                return -1;
+            }
+            nil_gate_mport_set_blob(port, view.buf, static_cast<size_t>(view.len));
+            PyBuffer_Release(&view);
+            return 0;
+        }
+
+        if (kind->kind == EKind::Buffer)
+        {
+            auto* view = borrow_buffer(value);
+            if (view == nullptr)
+            {
+                return -1;
+            }
+            nil_gate_mport_set_blob_ref(
+                port,
+                view->buf,
+                static_cast<size_t>(view->len),
+                view,
+                &release_buffer
+            );
+            return 0;
+        }
+
+        Scalar scalar = {};
+        if (to_scalar(kind->kind, value, scalar) < 0)
+        {
+            return -1;
+        }
+        switch (kind->kind)
+        {
+            case EKind::I64:
+                nil_gate_mport_set_i64(port, scalar.i64);
+                break;
+            case EKind::F64:
+                nil_gate_mport_set_f64(port, scalar.f64);
+                break;
+            case EKind::Bool:
+            default:
+                nil_gate_mport_set_bool(port, scalar.boolean);
+                break;
+        }
+        return 0;
+    }
+
+    // arguments of a METH_FASTCALL | METH_KEYWORDS call in the order of `names`.
+    // the first `required` must be given, the others are left untouched when missing.
+    // returns 0 on success, -1 with a python exception set
+    template <std::size_t N>
+    int parse_args(
+        const char* usage,
+        PyObject* const* args,
+        Py_ssize_t nargs,
+        PyObject* kwnames,
+        const std::array<const char*, N>& names,
+        std::size_t required,
+        std::array<PyObject*, N>& out
+    )
+    {
+        if (nargs > static_cast<Py_ssize_t>(N))
+        {
+            PyErr_SetString(PyExc_TypeError, usage);
+            return -1;
+        }
+        auto given = std::array<bool, N>();
+        for (Py_ssize_t i = 0; i < nargs; ++i)
+        {
+            out[static_cast<std::size_t>(i)] = args[i];
+            given[static_cast<std::size_t>(i)] = true;
+        }
+
+        const auto kwsize = kwnames == nullptr ? 0 : PyTuple_GET_SIZE(kwnames);
+        for (Py_ssize_t k = 0; k < kwsize; ++k)
+        {
+            PyObject* name = PyTuple_GET_ITEM(kwnames, k);
+            auto i = 0U;
+            while (i < N && PyUnicode_CompareWithASCIIString(name, names[i]) != 0)
+            {
+                ++i;
+            }
+            if (i == N || given[i])
+            {
+                PyErr_SetString(PyExc_TypeError, usage);
+                return -1;
+            }
+            out[i] = args[nargs + k];
+            given[i] = true;
+        }
+
+        for (auto i = 0U; i < required; ++i)
+        {
+            if (!given[i])
+            {
+                PyErr_SetString(PyExc_TypeError, usage);
+                return -1;
+            }
+        }
+        return 0;
+    }
+
+    // python types
+    PyTypeObject* core_type = nullptr;
+    PyTypeObject* graph_type = nullptr;
+    PyTypeObject* node_type = nullptr;
+    PyTypeObject* executor_type = nullptr;
+    PyTypeObject* node_args_type = nullptr;
+    PyTypeObject* eport_type = nullptr;
+    PyTypeObject* mport_type = nullptr;
+    PyTypeObject* rport_type = nullptr;
+    PyTypeObject* changes_type = nullptr;
+    PyTypeObject* gate_type = nullptr;
+
+    struct Core
+    {
+        PyObject_HEAD
+        nil_gate_core core;
+        bool host;
+    };
+
+    struct Graph
+    {
+        PyObject_HEAD
+        nil_gate_graph graph;
+        bool host;
+    };
+
+    struct Node
+    {
+        PyObject_HEAD
+        nil_gate_node node;
+    };
+
+    struct Executor
+    {
+        PyObject_HEAD
+        nil_gate_task_queue queue;
+    };
+
+    struct NodeArgs
+    {
+        PyObject_HEAD
+        PyObject* core;
+        PyObject* inputs;
+        PyObject* outputs;
+    };
+
+    struct EPort
+    {
+        PyObject_HEAD
+        nil_gate_eport port;
+        PyObject* eq;
+    };
+
+    struct MPort
+    {
+        PyObject_HEAD
+        nil_gate_mport port;
+        PyObject* eq;
+    };
+
+    struct RPort
+    {
+        PyObject_HEAD
+        nil_gate_rport port;
+    };
+
+    struct Changes
+    {
+        PyObject_HEAD
+        std::vector<nil_gate_rport>* ports;
+        std::vector<std::uint64_t>* versions;
+        std::vector<std::uint8_t>* changed;
+    };
+
+    template <typename T>
+    T* alloc(PyTypeObject* type)
+    {
+        return PyObject_New(T, type);
+    }
+
+    PyObject* new_core(nil_gate_core core, bool host)
+    {
+        auto* self = alloc<Core>(core_type);
+        if (self != nullptr)
+        {
+            self->core = core;
+            self->host = host;
+        }
+        return reinterpret_cast<PyObject*>(self);
+    }
+
+    PyObject* new_rport(nil_gate_rport port)
+    {
+        auto* self = alloc<RPort>(rport_type);
+        if (self != nullptr)
+        {
+            self->port = port;
+        }
+        return reinterpret_cast<PyObject*>(self);
+    }
+
+    PyObject* new_mport(nil_gate_mport port, PyObject* eq)
+    {
+        auto* self = alloc<MPort>(mport_type);
+        if (self != nullptr)
+        {
+            self->port = port;
+            Py_INCREF(eq);
+            self->eq = eq;
+        }
+        return reinterpret_cast<PyObject*>(self);
+    }
+
+    PyObject* new_eport(nil_gate_eport port, PyObject* eq)
+    {
+        auto* self = alloc<EPort>(eport_type);
+        if (self != nullptr)
+        {
+            self->port = port;
+            Py_INCREF(eq);
+            self->eq = eq;
+        }
+        return reinterpret_cast<PyObject*>(self);
+    }
+
+    // accepts RPort, MPort, EPort or anything with `as_input()`
+    int to_rport(PyObject* object, nil_gate_rport& out)
+    {
+        if (Py_IS_TYPE(object, rport_type))
+        {
+            out = reinterpret_cast<RPort*>(object)->port;
+            return 0;
+        }
+        if (Py_IS_TYPE(object, mport_type))
+        {
+            out = nil_gate_mport_as_input(reinterpret_cast<MPort*>(object)->port);
+            return 0;
+        }
+        if (Py_IS_TYPE(object, eport_type))
+        {
+            out = nil_gate_eport_as_input(reinterpret_cast<EPort*>(object)->port);
+            return 0;
+        }
+
+        PyObject* input = PyObject_CallMethod(object, "as_input", nullptr);
+        if (input == nullptr)
+        {
+            return -1;
+        }
+        const auto result = Py_IS_TYPE(input, rport_type) ? 0 : -1;
+        if (result == 0)
+        {
+            out = reinterpret_cast<RPort*>(input)->port;
+        }
+        else
+        {
+            PyErr_SetString(PyExc_TypeError, "expected a port");
+        }
+        Py_DECREF(input);
+        return result;
+    }
+
+    // context of a node registered from python
+    struct NodeState
+    {
+        PyObject* fn;
+        PyObject* outputs;     // TypeKind per output
+        PyObject* out_ports;   // MPort per output, created on the first execution
+        PyObject* core;        // Core passed to the node, created on the first execution
+        std::vector<nil_gate_port_info> inputs;
+    };
+
+    void node_cleanup(void* context)
+    {
+        auto* state = static_cast<NodeState*>(context);
+        {
+            const GIL gil;
+            Py_DECREF(state->fn);
+            Py_DECREF(state->outputs);
+            Py_XDECREF(state->out_ports);
+            Py_XDECREF(state->core);
+        }
+        delete state; // NOLINT
+    }
+
+    // returns 0 on success, -1 with a python exception set
+    int run_node(const nil_gate_node_args* args, bool host)
+    {
+        auto* state = static_cast<NodeState*>(args->context);
+
+        if (state->out_ports == nullptr)
+        {
+            state->out_ports = PyList_New(args->outputs.size);
+            if (state->out_ports == nullptr)
+            {
+                return -1;
+            }
+            for (auto i = 0U; i < args->outputs.size; ++i)
+            {
+                PyObject* port = new_mport(
+                    args->outputs.ports[i], // NOLINT
+                    PyList_GET_ITEM(state->outputs, i)
+                );
+                if (port == nullptr)
+                {
+                    return -1;
+                }
+                PyList_SET_ITEM(state->out_ports, i, port);
+            }
+        }
+
+        if (state->core == nullptr)
+        {
+            state->core = new_core(args->core, host);
+            if (state->core == nullptr)
+            {
+                return -1;
+            }
+        }
+
+        PyObject* inputs = PyList_New(args->inputs.size);
+        if (inputs == nullptr)
+        {
+            return -1;
+        }
+        for (auto i = 0U; i < args->inputs.size; ++i)
+        {
+            PyObject* value = read_value(state->inputs[i], args->inputs.data[i]); // NOLINT
+            if (value == nullptr)
+            {
+                Py_DECREF(inputs);
+                return -1;
+            }
+            PyList_SET_ITEM(inputs, i, value);
+        }
+
+        auto* node_args = alloc<NodeArgs>(node_args_type);
+        if (node_args == nullptr)
+        {
+            Py_DECREF(inputs);
+            return -1;
+        }
+        Py_INCREF(state->core);
+        Py_INCREF(state->out_ports);
+        node_args->core = state->core;
+        node_args->inputs = inputs;
+        node_args->outputs = state->out_ports;
+
+        PyObject* call_args[] = {reinterpret_cast<PyObject*>(node_args)};
+        PyObject* result = PyObject_Vectorcall(state->fn, call_args, 1, nullptr);
+        Py_DECREF(node_args);
+        if (result == nullptr)
+        {
+            return -1;
+        }
+        Py_DECREF(result);
+        return 0;
+    }
+
+    void node_exec(const nil_gate_node_args* args)
+    {
+        const GIL gil;
+        if (run_node(args, false) < 0)
+        {
+            PyErr_WriteUnraisable(static_cast<NodeState*>(args->context)->fn);
+        }
+    }
+
+    // cores currently inside `drive`. commits from host nodes are picked up by the same loop.
+    std::vector<void*> driving; // NOLINT
+
+    int drive(nil_gate_core core)
+    {
+        for (auto* d : driving)
+        {
+            if (d == core.handle)
+            {
+                return 0;
+            }
+        }
+
+        driving.push_back(core.handle);
+        auto result = 0;
+        for (auto b = nil_gate_core_next(core); b.size > 0 && result == 0; b = nil_gate_core_next(core))
+        {
+            for (auto i = 0U; i < b.size && result == 0; ++i)
+            {
+                result = run_node(b.args[i], true); // NOLINT
+            }
+            nil_gate_core_done(core);
+        }
+        std::erase(driving, core.handle);
+        return result;
+    }
+
+    // executors per core handle, closed when the core is destroyed
+    std::vector<std::pair<void*, PyObject*>> executors; // NOLINT
+
+    void close_executor(Executor* e)
+    {
+        if (e->queue.handle != nullptr)
+        {
+            nil_gate_task_queue_destroy(e->queue);
+            e->queue.handle = nullptr;
+        }
+    }
+
+    // context of a callable posted from python
+    struct CallableState
+    {
+        PyObject* fn;
+        bool host;
+    };
+
+    void callable_exec(nil_gate_graph* graph, void* context)
+    {
+        const GIL gil;
+        auto* state = static_cast<CallableState*>(context);
+        auto* g = alloc<Graph>(graph_type);
+        if (g == nullptr)
+        {
+            PyErr_WriteUnraisable(state->fn);
+            return;
+        }
+        g->graph = *graph;
+        g->host = state->host;
+
+        PyObject* call_args[] = {reinterpret_cast<PyObject*>(g)};
+        PyObject* result = PyObject_Vectorcall(state->fn, call_args, 1, nullptr);
+        Py_DECREF(g);
+        if (result == nullptr)
+        {
+            PyErr_WriteUnraisable(state->fn);
+            return;
+        }
+        Py_DECREF(result);
+    }
+
+    void callable_cleanup(void* context)
+    {
+        auto* state = static_cast<CallableState*>(context);
+        {
+            const GIL gil;
+            Py_DECREF(state->fn);
+        }
+        delete state; // NOLINT
+    }
+
+    nil_gate_core_callable to_callable(PyObject* fn, bool host)
+    {
+        Py_INCREF(fn);
+        return {
+            .exec = &callable_exec,
+            .context = new CallableState{.fn = fn, .host = host}, // NOLINT
+            .cleanup = &callable_cleanup
+        };
+    }
+
+    // Kind
+    PyObject* kind_read(PyObject* self, PyObject* ptr)
+    {
+        void* address = PyLong_AsVoidPtr(ptr);
+        if (address == nullptr)
+        {
+            if (PyErr_Occurred() == nullptr)
+            {
+                PyErr_SetString(PyExc_ValueError, "null pointer");
+            }
+            return nullptr;
+        }
+        return read_value(kind_info(reinterpret_cast<Kind*>(self)->kind), address);
+    }
+
+    // instances of heap types hold a reference to their type
+    void free_object(PyObject* self)
+    {
+        auto* type = Py_TYPE(self);
+        PyObject_Free(self);
+        Py_DECREF(type);
+    }
+
+    void kind_dealloc(PyObject* self)
+    {
+        Py_XDECREF(reinterpret_cast<Kind*>(self)->name);
+        free_object(self);
+    }
+
+    PyObject* kind_get_name(PyObject* self, void* /* closure */)
+    {
+        auto* name = reinterpret_cast<Kind*>(self)->name;
+        Py_INCREF(name);
+        return name;
+    }
+
+    // Core
+    PyObject* core_destroy(PyObject* self, PyObject* /* args */)
+    {
+        auto* c = reinterpret_cast<Core*>(self);
+        if (c->core.handle != nullptr)
+        {
+            // the async runner joins threads that may be waiting for the GIL
+            Py_BEGIN_ALLOW_THREADS
+            nil_gate_core_unset_runner(c->core);
+            Py_END_ALLOW_THREADS
+            std::erase_if(
+                executors,
+                [c](const auto& entry)
+                {
+                    if (entry.first != c->core.handle)
+                    {
+                        return false;
+                    }
+                    close_executor(reinterpret_cast<Executor*>(entry.second));
+                    Py_DECREF(entry.second);
+                    return true;
+                }
+            );
+            nil_gate_core_destroy(c->core);
+            c->core.handle = nullptr;
+        }
+        Py_RETURN_NONE;
+    }
+
+    PyObject* core_executor(PyObject* self, PyObject* tag)
+    {
+        auto* c = reinterpret_cast<Core*>(self);
+        const auto value = PyLong_AsUnsignedLong(tag);
+        if (PyErr_Occurred() != nullptr)
+        {
+            return nullptr;
+        }
+        auto* e = alloc<Executor>(executor_type);
+        if (e == nullptr)
+        {
+            return nullptr;
+        }
+        e->queue = nil_gate_task_queue_create();
+        nil_gate_core_set_executor(
+            c->core,
+            static_cast<std::uint32_t>(value),
+            nil_gate_task_queue_executor(e->queue)
+        );
+        Py_INCREF(e);
+        executors.emplace_back(c->core.handle, reinterpret_cast<PyObject*>(e));
+        return reinterpret_cast<PyObject*>(e);
+    }
+
+    PyObject* core_post(PyObject* self, PyObject* fn)
+    {
+        auto* c = reinterpret_cast<Core*>(self);
+        nil_gate_core_post(c->core, to_callable(fn, c->host));
+        Py_RETURN_NONE;
+    }
+
+    PyObject* core_commit(PyObject* self, PyObject* /* args */)
+    {
+        auto* c = reinterpret_cast<Core*>(self);
+        nil_gate_core_commit(c->core);
+        if (c->host && drive(c->core) < 0)
+        {
+            return nullptr;
+        }
+        Py_RETURN_NONE;
+    }
+
+    PyObject* core_apply(PyObject* self, PyObject* fn)
+    {
+        auto* c = reinterpret_cast<Core*>(self);
+        nil_gate_core_apply(c->core, to_callable(fn, c->host));
+        if (c->host && drive(c->core) < 0)
+        {
+            return nullptr;
+        }
+        Py_RETURN_NONE;
+    }
+
+    // Graph
+    PyObject* graph_port(
+        PyObject* self,
+        PyObject* const* args,
+        Py_ssize_t nargs,
+        PyObject* kwnames
+    )
+    {
+        auto parsed = std::array<PyObject*, 2>{nullptr, Py_None};
+        const auto usage = "port(eq, value=None)";
+        if (parse_args(usage, args, nargs, kwnames, {"eq", "value"}, 1, parsed) < 0)
+        {
+            return nullptr;
+        }
+
+        auto graph = reinterpret_cast<Graph*>(self)->graph;
+        PyObject* eq = parsed[0];
+        PyObject* value = parsed[1];
+
+        nil_gate_eport port = {};
+        const auto* kind = as_kind(eq);
+        if (value == Py_None)
+        {
+            port = nil_gate_graph_port(graph, info_of(eq), nullptr);
+        }
+        else if (kind == nullptr)
+        {
+            port = nil_gate_graph_port(graph, value_info, make_value(value, eq));
+        }
+        else if (kind->kind == EKind::Blob)
+        {
+            Py_buffer view;
+            if (PyObject_GetBuffer(value, &view, PyBUF_SIMPLE) < 0)
+            {
+                return nullptr;
+            }
+            port = nil_gate_graph_port_blob(graph, view.buf, static_cast<size_t>(view.len));
+            PyBuffer_Release(&view);
+        }
+        else if (kind->kind == EKind::Buffer)
+        {
+            auto* view = borrow_buffer(value);
+            if (view == nullptr)
+            {
+                return nullptr;
+            }
+            port = nil_gate_graph_port_blob_ref(
+                graph,
+                view->buf,
+                static_cast<size_t>(view->len),
+                view,
+                &release_buffer
+            );
+        }
+        else
+        {
+            Scalar scalar = {};
+            if (to_scalar(kind->kind, value, scalar) < 0)
+            {
+                return nullptr;
+            }
+            switch (kind->kind)
+            {
+                case EKind::I64:
+                    port = nil_gate_graph_port_i64(graph, scalar.i64);
+                    break;
+                case EKind::F64:
+                    port = nil_gate_graph_port_f64(graph, scalar.f64);
+                    break;
+                case EKind::Bool:
+                default:
+                    port = nil_gate_graph_port_bool(graph, scalar.boolean);
+                    break;
+            }
+        }
+        return new_eport(port, eq);
+    }
+
+    PyObject* graph_node(
+        PyObject* self,
+        PyObject* const* args,
+        Py_ssize_t nargs,
+        PyObject* kwnames
+    )
+    {
+        auto parsed = std::array<PyObject*, 3>();
+        const auto usage = "node(fn, inputs, outputs)";
+        if (parse_args(usage, args, nargs, kwnames, {"fn", "inputs", "outputs"}, 3, parsed) < 0)
+        {
+            return nullptr;
+        }
+
+        auto* g = reinterpret_cast<Graph*>(self);
+        PyObject* inputs = PySequence_Fast(parsed[1], "inputs must be a sequence");
+        if (inputs == nullptr)
+        {
+            return nullptr;
+        }
+        PyObject* outputs = PySequence_List(parsed[2]);
+        if (outputs == nullptr)
+        {
+            Py_DECREF(inputs);
+            return nullptr;
+        }
+
+        const auto input_size = PySequence_Fast_GET_SIZE(inputs);
+        const auto output_size = PyList_GET_SIZE(outputs);
+        std::vector<nil_gate_rport> rports(static_cast<std::size_t>(input_size));
+        for (Py_ssize_t i = 0; i < input_size; ++i)
+        {
+            if (to_rport(PySequence_Fast_GET_ITEM(inputs, i), rports[i]) < 0)
+            {
+                Py_DECREF(inputs);
+                Py_DECREF(outputs);
+                return nullptr;
+            }
+        }
+        Py_DECREF(inputs);
+
+        std::vector<nil_gate_port_info> infos(static_cast<std::size_t>(output_size));
+        for (Py_ssize_t i = 0; i < output_size; ++i)
+        {
+            infos[i] = info_of(PyList_GET_ITEM(outputs, i));
+        }
+
+        auto* state = new NodeState{ // NOLINT
+            .fn = parsed[0],
+            .outputs = outputs,
+            .out_ports = nullptr,
+            .core = nullptr,
+            .inputs = {}
+        };
+        Py_INCREF(state->fn);
+        state->inputs.reserve(rports.size());
+        for (const auto& r : rports)
+        {
+            state->inputs.push_back(r.info);
+        }
+
+        const auto node = nil_gate_graph_node(
+            g->graph,
+            nil_gate_node_info{
+                // host-driven cores run the node from their own loop, not through a callback
+                .exec = g->host ? nullptr : &node_exec,
+                .inputs = {.size = static_cast<std::uint8_t>(rports.size()), .ports = rports.data()},
+                .outputs = {.size = static_cast<std::uint8_t>(infos.size()), .infos = infos.data()},
+                .context = state,
+                .cleanup = &node_cleanup
+            }
+        );
+
+        auto* self_node = alloc<Node>(node_type);
+        if (self_node != nullptr)
+        {
+            self_node->node = node;
+        }
+        return reinterpret_cast<PyObject*>(self_node);
+    }
+
+    // Node
+    PyObject* node_outputs(PyObject* self, PyObject* /* args */)
+    {
+        const auto node = reinterpret_cast<Node*>(self)->node;
+        const auto size = nil_gate_node_output_size(node);
+        std::vector<nil_gate_rport> rports(size);
+        if (size > 0)
+        {
+            nil_gate_node_outputs(node, rports.data());
+        }
+
+        PyObject* list = PyList_New(size);
+        if (list == nullptr)
+        {
+            return nullptr;
+        }
+        for (auto i = 0U; i < size; ++i)
+        {
+            PyObject* port = new_rport(rports[i]);
+            if (port == nullptr)
+            {
+                Py_DECREF(list);
+                return nullptr;
+            }
+            PyList_SET_ITEM(list, i, port);
+        }
+        return list;
+    }
+
+    PyObject* node_set_affinity(PyObject* self, PyObject* tag)
+    {
+        const auto value = PyLong_AsUnsignedLong(tag);
+        if (PyErr_Occurred() != nullptr)
+        {
+            return nullptr;
+        }
+        nil_gate_node_set_affinity(
+            reinterpret_cast<Node*>(self)->node,
+            static_cast<std::uint32_t>(value)
+        );
+        Py_RETURN_NONE;
+    }
+
+    // Executor
+    void executor_dealloc(PyObject* self)
+    {
+        close_executor(reinterpret_cast<Executor*>(self));
+        free_object(self);
+    }
+
+    PyObject* executor_run(
+        PyObject* self,
+        PyObject* const* args,
+        Py_ssize_t nargs,
+        PyObject* kwnames
+    )
+    {
+        auto parsed = std::array<PyObject*, 1>{nullptr};
+        const auto usage = "run(timeout=0.0)";
+        if (parse_args(usage, args, nargs, kwnames, {"timeout"}, 0, parsed) < 0)
+        {
+            return nullptr;
+        }
+        const auto timeout = parsed[0] == nullptr ? 0.0 : PyFloat_AsDouble(parsed[0]);
+        if (PyErr_Occurred() != nullptr)
+        {
+            return nullptr;
+        }
+
+        const auto queue = reinterpret_cast<Executor*>(self)->queue;
+        if (queue.handle == nullptr)
+        {
+            return PyLong_FromSize_t(0);
+        }
+        // the nodes take the GIL back, the runner threads need it while waiting
+        size_t count = 0;
+        Py_BEGIN_ALLOW_THREADS
+        count = nil_gate_task_queue_run(queue, static_cast<std::uint32_t>(timeout * 1000));
+        Py_END_ALLOW_THREADS
+        return PyLong_FromSize_t(count);
+    }
+
+    // NodeArgs
+    void node_args_dealloc(PyObject* self)
+    {
+        auto* a = reinterpret_cast<NodeArgs*>(self);
+        Py_XDECREF(a->core);
+        Py_XDECREF(a->inputs);
+        Py_XDECREF(a->outputs);
+        free_object(self);
+    }
+
+    PyObject* node_args_get_core(PyObject* self, void* /* closure */)
+    {
+        auto* o = reinterpret_cast<NodeArgs*>(self)->core;
+        Py_INCREF(o);
+        return o;
+    }
+
+    PyObject* node_args_get_inputs(PyObject* self, void* /* closure */)
+    {
+        auto* o = reinterpret_cast<NodeArgs*>(self)->inputs;
+        Py_INCREF(o);
+        return o;
+    }
+
+    PyObject* node_args_get_outputs(PyObject* self, void* /* closure */)
+    {
+        auto* o = reinterpret_cast<NodeArgs*>(self)->outputs;
+        Py_INCREF(o);
+        return o;
+    }
+
+    // EPort
+    void eport_dealloc(PyObject* self)
+    {
+        Py_XDECREF(reinterpret_cast<EPort*>(self)->eq);
+        free_object(self);
+    }
+
+    PyObject* eport_to_direct(PyObject* self, PyObject* /* args */)
+    {
+        auto* p = reinterpret_cast<EPort*>(self);
+        return new_mport(nil_gate_eport_to_direct(p->port), p->eq);
+    }
+
+    PyObject* eport_as_input(PyObject* self, PyObject* /* args */)
+    {
+        return new_rport(nil_gate_eport_as_input(reinterpret_cast<EPort*>(self)->port));
+    }
+
+    // MPort
+    void mport_dealloc(PyObject* self)
+    {
+        Py_XDECREF(reinterpret_cast<MPort*>(self)->eq);
+        free_object(self);
+    }
+
+    PyObject* mport_value(PyObject* self, PyObject* /* args */)
+    {
+        return read_port(nil_gate_mport_as_input(reinterpret_cast<MPort*>(self)->port));
+    }
+
+    PyObject* mport_has_value(PyObject* self, PyObject* /* args */)
+    {
+        const auto port = nil_gate_mport_as_input(reinterpret_cast<MPort*>(self)->port);
+        return PyBool_FromLong(nil_gate_rport_has_value(port));
+    }
+
+    PyObject* mport_set_value(PyObject* self, PyObject* value)
+    {
+        auto* p = reinterpret_cast<MPort*>(self);
+        if (set_port(p->port, p->eq, value) < 0)
+        {
+            return nullptr;
+        }
+        Py_RETURN_NONE;
+    }
+
+    PyObject* mport_unset_value(PyObject* self, PyObject* /* args */)
+    {
+        nil_gate_mport_unset_value(reinterpret_cast<MPort*>(self)->port);
+        Py_RETURN_NONE;
+    }
+
+    PyObject* mport_as_input(PyObject* self, PyObject* /* args */)
+    {
+        return new_rport(nil_gate_mport_as_input(reinterpret_cast<MPort*>(self)->port));
+    }
+
+    // RPort
+    PyObject* rport_value(PyObject* self, PyObject* /* args */)
+    {
+        return read_port(reinterpret_cast<RPort*>(self)->port);
+    }
+
+    PyObject* rport_has_value(PyObject* self, PyObject* /* args */)
+    {
+        return PyBool_FromLong(nil_gate_rport_has_value(reinterpret_cast<RPort*>(self)->port));
+    }
+
+    PyObject* rport_as_input(PyObject* self, PyObject* /* args */)
+    {
+        Py_INCREF(self);
+        return self;
+    }
+
+    // batch access
+    PyObject* set_values(
+        PyObject* /* module */,
+        PyObject* const* args,
+        Py_ssize_t nargs,
+        PyObject* kwnames
+    )
+    {
+        auto parsed = std::array<PyObject*, 2>();
+        const auto usage = "set_values(ports, values)";
+        if (parse_args(usage, args, nargs, kwnames, {"ports", "values"}, 2, parsed) < 0)
+        {
+            return nullptr;
+        }
+
+        PyObject* ports = PySequence_Fast(parsed[0], "ports must be a sequence");
+        if (ports == nullptr)
+        {
+            return nullptr;
+        }
+        PyObject* values = PySequence_Fast(parsed[1], "values must be a sequence");
+        if (values == nullptr)
+        {
+            Py_DECREF(ports);
+            return nullptr;
+        }
+
+        const auto count = PySequence_Fast_GET_SIZE(ports);
+        if (count != PySequence_Fast_GET_SIZE(values))
+        {
+            Py_DECREF(ports);
+            Py_DECREF(values);
+            PyErr_SetString(PyExc_ValueError, "ports and values must have the same length");
+            return nullptr;
+        }
+
+        const auto size = static_cast<std::size_t>(count);
+        std::vector<nil_gate_mport> mports(size);
+        std::vector<void*> pointers(size, nullptr);
+        std::vector<Scalar> scalars(size);
+        std::vector<nil_gate_blob> blobs(size);
+        std::vector<Py_buffer> views;
+        views.reserve(size);
+        // borrowed buffers, handed over to the library with the batch
+        std::vector<void*> borrowed(size, nullptr);
+        // values of custom ports, owned here until handed over to the library
+        std::vector<void*> owned;
+
+        auto failed = false;
+        for (std::size_t i = 0; i < size && !failed; ++i)
+        {
+            PyObject* port = PySequence_Fast_GET_ITEM(ports, i);
+            PyObject* value = PySequence_Fast_GET_ITEM(values, i);
+            if (!Py_IS_TYPE(port, mport_type))
+            {
+                PyErr_SetString(PyExc_TypeError, "expected MPort");
+                failed = true;
+                break;
+            }
+
+            auto* p = reinterpret_cast<MPort*>(port);
+            mports[i] = p->port;
+            if (value == Py_None)
+            {
+                continue;
+            }
+
+            const auto* kind = as_kind(p->eq);
+            if (kind == nullptr)
+            {
+                pointers[i] = make_value(value, p->eq);
+                owned.push_back(pointers[i]);
+            }
+            else if (kind->kind == EKind::Blob)
+            {
+                views.emplace_back();
+                if (PyObject_GetBuffer(value, &views.back(), PyBUF_SIMPLE) < 0)
+                {
+                    views.pop_back();
+                    failed = true;
+                    break;
+                }
+                blobs[i] = {.size = static_cast<size_t>(views.back().len), .data = views.back().buf};
+                pointers[i] = &blobs[i];
+            }
+            else if (kind->kind == EKind::Buffer)
+            {
+                auto* view = borrow_buffer(value);
+                if (view == nullptr)
+                {
+                    failed = true;
+                    break;
+                }
+                borrowed[i] = view;
+                blobs[i] = {.size = static_cast<size_t>(view->len), .data = view->buf};
+                pointers[i] = &blobs[i];
+            }
+            else
+            {
+                failed = to_scalar(kind->kind, value, scalars[i]) < 0;
+                pointers[i] = &scalars[i];
+            }
+        }
+
+        if (failed)
+        {
+            for (auto* value : owned)
+            {
+                value_destroy(value);
+            }
+            for (auto* view : borrowed)
+            {
+                if (view != nullptr)
+                {
+                    release_buffer(view);
+                }
+            }
+        }
+        else
+        {
+            nil_gate_mports_set_values_ref(
+                mports.data(),
+                pointers.data(),
+                borrowed.data(),
+                &release_buffer,
+                size
+            );
+        }
+
+        for (auto& view : views)
+        {
+            PyBuffer_Release(&view);
+        }
+        Py_DECREF(ports);
+        Py_DECREF(values);
+        if (failed)
+        {
+            return nullptr;
+        }
+        Py_RETURN_NONE;
+    }
+
+    int to_rports(PyObject* sequence, std::vector<nil_gate_rport>& out)
+    {
+        PyObject* ports = PySequence_Fast(sequence, "ports must be a sequence");
+        if (ports == nullptr)
+        {
+            return -1;
+        }
+        const auto count = PySequence_Fast_GET_SIZE(ports);
+        out.resize(static_cast<std::size_t>(count));
+        for (Py_ssize_t i = 0; i < count; ++i)
+        {
+            if (to_rport(PySequence_Fast_GET_ITEM(ports, i), out[i]) < 0)
+            {
+                Py_DECREF(ports);
+                return -1;
+            }
+        }
+        Py_DECREF(ports);
+        return 0;
+    }
+
+    PyObject* read_values(PyObject* /* module */, PyObject* sequence)
+    {
+        std::vector<nil_gate_rport> rports;
+        if (to_rports(sequence, rports) < 0)
+        {
+            return nullptr;
+        }
+
+        std::vector<const void*> pointers(rports.size());
+        nil_gate_rports_values(rports.data(), pointers.data(), rports.size());
+
+        PyObject* list = PyList_New(static_cast<Py_ssize_t>(rports.size()));
+        if (list == nullptr)
+        {
+            return nullptr;
+        }
+        for (std::size_t i = 0; i < rports.size(); ++i)
+        {
+            PyObject* value = nullptr;
+            if (pointers[i] == nullptr)
+            {
+                Py_INCREF(Py_None);
+                value = Py_None;
+            }
+            else
+            {
+                value = read_value(rports[i].info, pointers[i]);
+            }
+            if (value == nullptr)
+            {
+                Py_DECREF(list);
+                return nullptr;
+            }
+            PyList_SET_ITEM(list, static_cast<Py_ssize_t>(i), value);
+        }
+        return list;
+    }
+
+    // Changes
+    PyObject* changes_new(PyTypeObject* type, PyObject* args, PyObject* kwargs)
+    {
+        PyObject* ports = nullptr;
+        static const char* keywords[] = {"ports", nullptr};
+        if (PyArg_ParseTupleAndKeywords(args, kwargs, "O", const_cast<char**>(keywords), &ports) == 0) // NOLINT
+        {
+            return nullptr;
+        }
+
+        auto rports = std::vector<nil_gate_rport>();
+        if (to_rports(ports, rports) < 0)
+        {
+            return nullptr;
+        }
+
+        auto* self = reinterpret_cast<Changes*>(type->tp_alloc(type, 0));
+        if (self == nullptr)
+        {
+            return nullptr;
+        }
+        const auto size = rports.size();
+        self->ports = new std::vector<nil_gate_rport>(std::move(rports)); // NOLINT
+        self->versions = new std::vector<std::uint64_t>(size, 0U);       // NOLINT
+        self->changed = new std::vector<std::uint8_t>(size, 0U);         // NOLINT
+        return reinterpret_cast<PyObject*>(self);
+    }
+
+    void changes_dealloc(PyObject* self)
+    {
+        auto* c = reinterpret_cast<Changes*>(self);
+        delete c->ports;    // NOLINT
+        delete c->versions; // NOLINT
+        delete c->changed;  // NOLINT
+        auto* type = Py_TYPE(self);
+        type->tp_free(self);
+        Py_DECREF(type);
+    }
+
+    PyObject* changes_poll(PyObject* self, PyObject* /* args */)
+    {
+        auto* c = reinterpret_cast<Changes*>(self);
+        const auto size = c->ports->size();
+        const auto count = size == 0
+            ? 0U
+            : nil_gate_rports_changed(c->ports->data(), c->versions->data(), c->changed->data(), size);
+
+        PyObject* list = PyList_New(static_cast<Py_ssize_t>(count));
+        if (list == nullptr)
+        {
+            return nullptr;
+        }
+        Py_ssize_t n = 0;
+        for (std::size_t i = 0; i < size && count > 0; ++i)
+        {
+            if ((*c->changed)[i] != 0)
+            {
+                PyList_SET_ITEM(list, n++, PyLong_FromSize_t(i));
+            }
+        }
+        return list;
+    }
+
+    // Gate / module
+    PyObject* create_core_impl(PyObject* const* args, Py_ssize_t nargs, PyObject* kwnames)
+    {
+        auto parsed = std::array<PyObject*, 2>{Py_False, nullptr};
+        const auto usage = "create_core(host_driven=False, threads=0)";
+        if (parse_args(usage, args, nargs, kwnames, {"host_driven", "threads"}, 0, parsed) < 0)
+        {
+            return nullptr;
+        }
+        const auto truth = PyObject_IsTrue(parsed[0]);
+        if (truth < 0)
+        {
+            return nullptr;
+        }
+        const auto host = truth != 0;
+        const auto threads = parsed[1] == nullptr ? 0UL : PyLong_AsUnsignedLong(parsed[1]);
+        if (PyErr_Occurred() != nullptr)
+        {
+            return nullptr;
+        }
+        if (host && threads > 0)
+        {
+            PyErr_SetString(PyExc_ValueError, "host_driven and threads are exclusive");
+            return nullptr;
+        }
+
+        const auto core = nil_gate_core_create();
+        if (host)
+        {
+            nil_gate_core_set_runner_host(core);
+        }
+        else if (threads > 0)
+        {
+            nil_gate_core_set_runner_async(core, static_cast<std::uint32_t>(threads));
+        }
+        else
+        {
+            nil_gate_core_set_runner_soft_blocking(core);
+        }
+        return new_core(core, host);
+    }
+
+    PyObject* create_core(
+        PyObject* /* module */,
+        PyObject* const* args,
+        Py_ssize_t nargs,
+        PyObject* kwnames
+    )
+    {
+        return create_core_impl(args, nargs, kwnames);
+    }
+
+    PyObject* gate_create_core(
+        PyObject* /* self */,
+        PyObject* const* args,
+        Py_ssize_t nargs,
+        PyObject* kwnames
+    )
+    {
+        return create_core_impl(args, nargs, kwnames);
+    }
+
+    PyObject* gate_new(PyTypeObject* type, PyObject* /* args */, PyObject* /* kwargs */)
+    {
+        // the library is linked in, `gate` is accepted for compatibility with the ctypes binding
+        return type->tp_alloc(type, 0);
+    }
+
+
+    // type definitions
+    PyMethodDef kind_methods[] = {
+        {"read", &kind_read, METH_O, "Reads a value of this kind from an address."},
+        {nullptr, nullptr, 0, nullptr}
+    };
+
+    PyGetSetDef kind_getset[] = {
+        {"name", &kind_get_name, nullptr, nullptr, nullptr},
+        {nullptr, nullptr, nullptr, nullptr, nullptr}
+    };
+
+    PyType_Slot kind_slots[] = {
+        {Py_tp_dealloc, reinterpret_cast<void*>(&kind_dealloc)},
+        {Py_tp_methods, kind_methods},
+        {Py_tp_getset, kind_getset},
+        {0, nullptr}
+    };
+
+    PyMethodDef core_methods[] = {
+        {"destroy", &core_destroy, METH_NOARGS, nullptr},
+        {"post", &core_post, METH_O, nullptr},
+        {"apply", &core_apply, METH_O, nullptr},
+        {"commit", &core_commit, METH_NOARGS, nullptr},
+        {"executor", &core_executor, METH_O, nullptr},
+        {nullptr, nullptr, 0, nullptr}
+    };
+
+    PyType_Slot core_slots[] = {
+        {Py_tp_dealloc, reinterpret_cast<void*>(&free_object)},
+        {Py_tp_methods, core_methods},
+        {0, nullptr}
+    };
+
+    PyMethodDef graph_methods[] = {
+        {"port",
+         reinterpret_cast<PyCFunction>(reinterpret_cast<void*>(&graph_port)),
+         METH_FASTCALL | METH_KEYWORDS,
+         nullptr},
+        {"node",
+         reinterpret_cast<PyCFunction>(reinterpret_cast<void*>(&graph_node)),
+         METH_FASTCALL | METH_KEYWORDS,
+         nullptr},
+        {nullptr, nullptr, 0, nullptr}
+    };
+
+    PyType_Slot graph_slots[] = {
+        {Py_tp_dealloc, reinterpret_cast<void*>(&free_object)},
+        {Py_tp_methods, graph_methods},
+        {0, nullptr}
+    };
+
+    PyMethodDef node_methods[] = {
+        {"outputs", &node_outputs, METH_NOARGS, nullptr},
+        {"set_affinity", &node_set_affinity, METH_O, nullptr},
+        {nullptr, nullptr, 0, nullptr}
+    };
+
+    PyType_Slot node_slots[] = {
+        {Py_tp_dealloc, reinterpret_cast<void*>(&free_object)},
+        {Py_tp_methods, node_methods},
+        {0, nullptr}
+    };
+
+    PyMethodDef executor_methods[] = {
+        {"run",
+         reinterpret_cast<PyCFunction>(reinterpret_cast<void*>(&executor_run)),
+         METH_FASTCALL | METH_KEYWORDS,
+         nullptr},
+        {nullptr, nullptr, 0, nullptr}
+    };
+
+    PyType_Slot executor_slots[] = {
+        {Py_tp_dealloc, reinterpret_cast<void*>(&executor_dealloc)},
+        {Py_tp_methods, executor_methods},
+        {0, nullptr}
+    };
+
+    PyGetSetDef node_args_getset[] = {
+        {"core", &node_args_get_core, nullptr, nullptr, nullptr},
+        {"inputs", &node_args_get_inputs, nullptr, nullptr, nullptr},
+        {"outputs", &node_args_get_outputs, nullptr, nullptr, nullptr},
+        {nullptr, nullptr, nullptr, nullptr, nullptr}
+    };
+
+    PyType_Slot node_args_slots[] = {
+        {Py_tp_dealloc, reinterpret_cast<void*>(&node_args_dealloc)},
+        {Py_tp_getset, node_args_getset},
+        {0, nullptr}
+    };
+
+    PyMethodDef eport_methods[] = {
+        {"to_direct", &eport_to_direct, METH_NOARGS, nullptr},
+        {"as_input", &eport_as_input, METH_NOARGS, nullptr},
+        {nullptr, nullptr, 0, nullptr}
+    };
+
+    PyType_Slot eport_slots[] = {
+        {Py_tp_dealloc, reinterpret_cast<void*>(&eport_dealloc)},
+        {Py_tp_methods, eport_methods},
+        {0, nullptr}
+    };
+
+    PyMethodDef mport_methods[] = {
+        {"value", &mport_value, METH_NOARGS, nullptr},
+        {"has_value", &mport_has_value, METH_NOARGS, nullptr},
+        {"set_value", &mport_set_value, METH_O, nullptr},
+        {"unset_value", &mport_unset_value, METH_NOARGS, nullptr},
+        {"as_input", &mport_as_input, METH_NOARGS, nullptr},
+        {nullptr, nullptr, 0, nullptr}
+    };
+
+    PyType_Slot mport_slots[] = {
+        {Py_tp_dealloc, reinterpret_cast<void*>(&mport_dealloc)},
+        {Py_tp_methods, mport_methods},
+        {0, nullptr}
+    };
+
+    PyMethodDef rport_methods[] = {
+        {"value", &rport_value, METH_NOARGS, nullptr},
+        {"has_value", &rport_has_value, METH_NOARGS, nullptr},
+        {"as_input", &rport_as_input, METH_NOARGS, nullptr},
+        {nullptr, nullptr, 0, nullptr}
+    };
+
+    PyType_Slot rport_slots[] = {
+        {Py_tp_dealloc, reinterpret_cast<void*>(&free_object)},
+        {Py_tp_methods, rport_methods},
+        {0, nullptr}
+    };
+
+    PyMethodDef changes_methods[] = {
+        {"poll", &changes_poll, METH_NOARGS, nullptr},
+        {nullptr, nullptr, 0, nullptr}
+    };
+
+    PyType_Slot changes_slots[] = {
+        {Py_tp_new, reinterpret_cast<void*>(&changes_new)},
+        {Py_tp_dealloc, reinterpret_cast<void*>(&changes_dealloc)},
+        {Py_tp_methods, changes_methods},
+        {0, nullptr}
+    };
+
+    PyMethodDef gate_methods[] = {
+        {"create_core",
+         reinterpret_cast<PyCFunction>(reinterpret_cast<void*>(&gate_create_core)),
+         METH_FASTCALL | METH_KEYWORDS,
+         nullptr},
+        {nullptr, nullptr, 0, nullptr}
+    };
+
+    PyType_Slot gate_slots[] = {
+        {Py_tp_new, reinterpret_cast<void*>(&gate_new)},
+        {Py_tp_methods, gate_methods},
+        {0, nullptr}
+    };
+
+    // instances are only created by the binding unless the type has its own `tp_new`
+    template <typename T>
+    PyTypeObject* make_type(const char* name, PyType_Slot* slots, unsigned int flags = Py_TPFLAGS_DISALLOW_INSTANTIATION)
+    {
+        PyType_Spec spec = {
+            .name = name,
+            .basicsize = static_cast<int>(sizeof(T)),
+            .itemsize = 0,
+            .flags = Py_TPFLAGS_DEFAULT | flags,
+            .slots = slots
+        };
+        return reinterpret_cast<PyTypeObject*>(PyType_FromSpec(&spec));
+    }
+
+    PyMethodDef module_methods[] = {
+        {"create_core",
+         reinterpret_cast<PyCFunction>(reinterpret_cast<void*>(&create_core)),
+         METH_FASTCALL | METH_KEYWORDS,
+         "create_core(host_driven=False, threads=0) -> Core"},
+        {"set_values",
+         reinterpret_cast<PyCFunction>(reinterpret_cast<void*>(&set_values)),
+         METH_FASTCALL | METH_KEYWORDS,
+         "Sets many ports with a single library call. None unsets the port."},
+        {"read_values",
+         &read_values,
+         METH_O,
+         "Reads many ports with a single library call. None for ports without a value."},
+        {nullptr, nullptr, 0, nullptr}
+    };
+
+    PyModuleDef module_def = {
+        .m_base = PyModuleDef_HEAD_INIT,
+        .m_name = "nil_gate_ext",
+        .m_doc = "Native binding of nil-gate. Same API as nil_gate.",
+        .m_size = -1,
+        .m_methods = module_methods,
+        .m_slots = nullptr,
+        .m_traverse = nullptr,
+        .m_clear = nullptr,
+        .m_free = nullptr
+    };
+
+    int add_type(PyObject* module, const char* name, PyTypeObject* type)
+    {
+        if (type == nullptr)
+        {
+            return -1;
+        }
+        Py_INCREF(type);
+        return PyModule_AddObject(module, name, reinterpret_cast<PyObject*>(type));
+    }
+}
+
+PyMODINIT_FUNC PyInit_nil_gate_ext(void) // NOLINT
+{
+    PyObject* module = PyModule_Create(&module_def);
+    if (module == nullptr)
+    {
+        return nullptr;
+    }
+
+    kind_type = make_type<Kind>("nil_gate_ext.Kind", kind_slots);
+    core_type = make_type<Core>("nil_gate_ext.Core", core_slots);
+    graph_type = make_type<Graph>("nil_gate_ext.Graph", graph_slots);
+    node_type = make_type<Node>("nil_gate_ext.Node", node_slots);
+    executor_type = make_type<Executor>("nil_gate_ext.Executor", executor_slots);
+    node_args_type = make_type<NodeArgs>("nil_gate_ext.NodeArgs", node_args_slots);
+    eport_type = make_type<EPort>("nil_gate_ext.EPort", eport_slots);
+    mport_type = make_type<MPort>("nil_gate_ext.MPort", mport_slots);
+    rport_type = make_type<RPort>("nil_gate_ext.RPort", rport_slots);
+    changes_type = make_type<Changes>("nil_gate_ext.Changes", changes_slots, 0);
+    gate_type = make_type<PyObject>("nil_gate_ext.Gate", gate_slots, 0);
+
+    if (add_type(module, "Kind", kind_type) < 0          //
+        || add_type(module, "Core", core_type) < 0       //
+        || add_type(module, "Graph", graph_type) < 0     //
+        || add_type(module, "Node", node_type) < 0       //
+        || add_type(module, "Executor", executor_type) < 0
+        || add_type(module, "NodeArgs", node_args_type) < 0
+        || add_type(module, "EPort", eport_type) < 0     //
+        || add_type(module, "MPort", mport_type) < 0     //
+        || add_type(module, "RPort", rport_type) < 0     //
+        || add_type(module, "Changes", changes_type) < 0 //
+        || add_type(module, "Gate", gate_type) < 0)
+    {
+        Py_DECREF(module);
+        return nullptr;
+    }
+
+    const char* names[] = {"I64", "F64", "BOOL", "BLOB", "BUFFER"};
+    const char* kind_names[] = {"i64", "f64", "bool", "blob", "buffer"};
+    for (auto i = 0U; i < 5U; ++i)
+    {
+        auto* kind = PyObject_New(Kind, kind_type);
+        if (kind == nullptr)
+        {
+            Py_DECREF(module);
+            return nullptr;
+        }
+        kind->kind = static_cast<EKind>(i);
+        kind->name = PyUnicode_FromString(kind_names[i]); // NOLINT
+        kinds[i] = reinterpret_cast<PyObject*>(kind);     // NOLINT
+        Py_INCREF(kinds[i]);                              // NOLINT
+        if (PyModule_AddObject(module, names[i], kinds[i]) < 0) // NOLINT
+        {
+            Py_DECREF(module);
+            return nullptr;
+        }
+    }
+
+    return module;
+}
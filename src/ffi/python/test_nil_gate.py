@@ -0,0 +1,278 @@
+"""Runs the same scenarios against both bindings: nil_gate (ctypes) and nil_gate_ext (compiled).
+
+    python test_nil_gate.py
+
+The library is `libnil-gate-c-api.so` next to `nil_gate.py`, or `NIL_GATE_LIBRARY` when set.
+The extension is imported from `sys.path` (`PYTHONPATH`), its tests are skipped when it is not built.
+"""
+
+import importlib
+import importlib.util
+import os
+import shutil
+import sys
+import tempfile
+import threading
+import time
+import unittest
+from pathlib import Path
+from typing import Any, List
+
+HERE = Path(__file__).resolve().parent
+
+
+def _load_ctypes() -> Any:
+    """nil_gate.py without the extension taking over."""
+    directory = HERE
+    library = os.environ.get("NIL_GATE_LIBRARY")
+    if library:
+        # nil_gate.py loads the library from its own directory
+        directory = Path(tempfile.mkdtemp())
+        shutil.copy(HERE / "nil_gate.py", directory / "nil_gate.py")
+        (directory / "libnil-gate-c-api.so").symlink_to(Path(library).resolve())
+
+    blocked = sys.modules.get("nil_gate_ext")
+    sys.modules["nil_gate_ext"] = None  # type: ignore[assignment]
+    try:
+        spec = importlib.util.spec_from_file_location("nil_gate_ctypes", directory / "nil_gate.py")
+        module = importlib.util.module_from_spec(spec)
+        sys.modules[spec.name] = module
+        spec.loader.exec_module(module)
+    finally:
+        if blocked is None:
+            del sys.modules["nil_gate_ext"]
+        else:
+            sys.modules["nil_gate_ext"] = blocked
+    return module
+
+
+def _load_ext() -> Any:
+    try:
+        return importlib.import_module("nil_gate_ext")
+    except ImportError:
+        return None
+
+
+CTYPES = _load_ctypes()
+EXT = _load_ext()
+
+
+class Scenarios:
+    """Mixed into one TestCase per binding. `ng` is the binding module."""
+
+    ng: Any
+
+    def setUp(self) -> None:
+        self.cores: List[Any] = []
+
+    def tearDown(self) -> None:
+        for core in self.cores:
+            core.destroy()
+
+    def core(self, **kwargs: Any) -> Any:
+        core = self.ng.create_core(**kwargs)
+        self.cores.append(core)
+        return core
+
+    def test_ports(self) -> None:
+        core = self.core()
+        ports = {}
+
+        def build(g: Any) -> None:
+            ports["a"] = g.port(lambda l, r: l == r, "x")
+            ports["b"] = g.port(eq=lambda l, r: l == r)
+            ports["c"] = g.port(self.ng.I64, value=3)
+
+        core.apply(build)
+        a = ports["a"].to_direct()
+        self.assertTrue(a.has_value())
+        self.assertEqual(a.value(), "x")
+        self.assertFalse(ports["b"].as_input().has_value())
+        self.assertEqual(ports["c"].as_input().value(), 3)
+
+        core.apply(lambda g: a.unset_value())
+        self.assertFalse(a.has_value())
+
+    def test_nodes(self) -> None:
+        core = self.core()
+        ports = {}
+        runs: List[Any] = []
+
+        def build(g: Any) -> None:
+            ports["a"] = g.port(lambda l, r: l == r, 1)
+
+            def double(args: Any) -> None:
+                runs.append(args.inputs[0])
+                args.outputs[0].set_value(args.inputs[0] * 2)
+
+            ports["node"] = g.node(
+                fn=double, inputs=[ports["a"]], outputs=[lambda l, r: l == r]
+            )
+
+        core.apply(build)
+        out = ports["node"].outputs()[0]
+        self.assertEqual(out.value(), 2)
+
+        core.apply(lambda g: ports["a"].to_direct().set_value(1))
+        self.assertEqual(runs, [1])
+
+        core.apply(lambda g: ports["a"].to_direct().set_value(4))
+        self.assertEqual(runs, [1, 4])
+        self.assertEqual(out.value(), 8)
+
+    def test_kinds(self) -> None:
+        ng = self.ng
+        core = self.core()
+        ports = {}
+
+        def build(g: Any) -> None:
+            ports["i64"] = g.port(ng.I64, -2)
+            ports["f64"] = g.port(ng.F64, 0.5)
+            ports["bool"] = g.port(ng.BOOL, True)
+            ports["blob"] = g.port(ng.BLOB, b"ab")
+
+            def fn(args: Any) -> None:
+                i, f, b, blob = args.inputs
+                args.outputs[0].set_value(i + len(blob))
+                args.outputs[1].set_value(f * 2)
+                args.outputs[2].set_value(not b)
+                args.outputs[3].set_value(bytes(blob) + b"!")
+
+            ports["node"] = g.node(
+                fn,
+                [ports["i64"], ports["f64"], ports["bool"], ports["blob"]],
+                [ng.I64, ng.F64, ng.BOOL, ng.BLOB],
+            )
+
+        core.apply(build)
+        outputs = ports["node"].outputs()
+        self.assertEqual([o.value() for o in outputs], [0, 1.0, False, b"ab!"])
+
+        core.apply(lambda g: ports["blob"].to_direct().set_value(b"abcd"))
+        self.assertEqual(outputs[0].value(), 2)
+        self.assertEqual(outputs[3].value(), b"abcd!")
+
+    def test_buffer(self) -> None:
+        ng = self.ng
+        core = self.core()
+        ports = {}
+        seen: List[bytes] = []
+
+        def build(g: Any) -> None:
+            ports["a"] = g.port(ng.BUFFER, bytearray(b"\x01\x02"))
+            g.node(lambda args: seen.append(bytes(args.inputs[0])), [ports["a"]], [])
+
+        core.apply(build)
+        self.assertEqual(seen, [b"\x01\x02"])
+
+        # equal bytes do not trigger the node
+        core.apply(lambda g: ports["a"].to_direct().set_value(bytearray(b"\x01\x02")))
+        self.assertEqual(seen, [b"\x01\x02"])
+
+        core.apply(lambda g: ports["a"].to_direct().set_value(bytearray(b"\x03")))
+        self.assertEqual(seen, [b"\x01\x02", b"\x03"])
+        self.assertEqual(bytes(ports["a"].as_input().value()), b"\x03")
+
+    def test_batch(self) -> None:
+        ng = self.ng
+        core = self.core()
+        ports: List[Any] = []
+
+        def build(g: Any) -> None:
+            ports.append(g.port(ng.I64, 0))
+            ports.append(g.port(ng.I64, 0))
+            ports.append(g.port(lambda l, r: l == r, "x"))
+
+        core.apply(build)
+        mports = [p.to_direct() for p in ports]
+        rports = [p.as_input() for p in ports]
+        changes = ng.Changes(rports)
+        changes.poll()
+
+        core.apply(lambda g: ng.set_values(mports[:2], [0, 7]))
+        self.assertEqual(changes.poll(), [1])
+        self.assertEqual(ng.read_values(rports), [0, 7, "x"])
+
+        core.apply(lambda g: ng.set_values(ports=mports, values=[1, None, "y"]))
+        self.assertEqual(changes.poll(), [0, 1, 2])
+        self.assertEqual(ng.read_values(rports), [1, None, "y"])
+        self.assertEqual(changes.poll(), [])
+
+    def test_host_driven(self) -> None:
+        ng = self.ng
+        core = self.core(host_driven=True)
+        ports = {}
+        runs: List[Any] = []
+
+        def build(g: Any) -> None:
+            ports["a"] = g.port(ng.I64, 1)
+            node = g.node(
+                lambda args: args.outputs[0].set_value(args.inputs[0] * 10), [ports["a"]], [ng.I64]
+            )
+
+            def sink(args: Any) -> None:
+                runs.append(args.inputs[0])
+                # commits from a host node are picked up by the same loop
+                if args.inputs[0] < 30:
+                    value = args.inputs[0] // 10 + 1
+                    args.core.post(lambda g: ports["a"].to_direct().set_value(value))
+                    args.core.commit()
+
+            g.node(sink, node.outputs(), [])
+
+        core.apply(build)
+        self.assertEqual(runs, [10, 20, 30])
+
+        core.apply(lambda g: ports["a"].to_direct().set_value(3))
+        self.assertEqual(runs, [10, 20, 30])
+
+        core.apply(lambda g: ports["a"].to_direct().set_value(5))
+        self.assertEqual(runs, [10, 20, 30, 50])
+
+    def test_affinity(self) -> None:
+        ng = self.ng
+        core = self.core(threads=2)
+        executor = core.executor(1)
+        ports = {}
+        runs: List[Any] = []
+
+        def build(g: Any) -> None:
+            ports["a"] = g.port(ng.I64, 1)
+            node = g.node(lambda args: runs.append((args.inputs[0], threading.get_ident())), [ports["a"]], [])
+            node.set_affinity(1)
+
+        def wait_for(count: int) -> None:
+            deadline = time.monotonic() + 10
+            while len(runs) < count and time.monotonic() < deadline:
+                executor.run(0.1)
+
+        # the tagged node runs on the thread draining its executor, not on the runner threads
+        core.apply(build)
+        wait_for(1)
+        core.apply(lambda g: ports["a"].to_direct().set_value(4))
+        wait_for(2)
+        self.assertEqual(runs, [(1, threading.get_ident()), (4, threading.get_ident())])
+        self.assertEqual(executor.run(), 0)
+
+        with self.assertRaises(ValueError):
+            self.core(host_driven=True, threads=1)
+
+    def test_gate_create_core(self) -> None:
+        gate = self.ng.Gate(None) if self.ng is EXT else self.ng._GATE
+        core = gate.create_core(host_driven=False)
+        self.cores.append(core)
+        with self.assertRaises(TypeError):
+            gate.create_core(host=True)
+
+
+class CtypesTest(Scenarios, unittest.TestCase):
+    ng = CTYPES
+
+
+@unittest.skipIf(EXT is None, "nil_gate_ext is not built")
+class ExtTest(Scenarios, unittest.TestCase):
+    ng = EXT
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -27,6 +27,104 @@ extern "C"
     void nil_gate_core_set_runner_async(nil_gate_core core, uint32_t thread_count);
     void nil_gate_core_unset_runner(nil_gate_core core);
 
+    // thread affinity (async runner only). nodes with a non-zero affinity tag
+    // (nil_gate_node_set_affinity) are handed to the executor registered for the tag,
+    // or run on a dedicated thread per tag when there is none.
+    // NOLINTNEXTLINE(modernize-use-using)
+    typedef struct nil_gate_task
+    {
+        void* handle;
+    } nil_gate_task;
+
+    // runs the task and releases it. every posted task must be run exactly once.
+    void nil_gate_task_run(nil_gate_task task);
+
+    // NOLINTNEXTLINE(modernize-use-using)
+    typedef struct nil_gate_executor
+    {
+        void (*post)(nil_gate_task task, void* context); // called from a runner thread
+        void* context;
+        void (*cleanup)(void*);
+    } nil_gate_executor;
+
+    // applies to the current async runner (no-op for the others). `post == NULL` restores
+    // the dedicated thread for the tag. pending tasks must be run before the runner is replaced.
+    void nil_gate_core_set_executor(nil_gate_core core, uint32_t tag, nil_gate_executor executor);
+
+    // executor drained by the host on its own thread, for bindings whose callbacks can not
+    // run on the runner threads (e.g. a Lua state, or Python without contending on the GIL).
+    // NOLINTNEXTLINE(modernize-use-using)
+    typedef struct nil_gate_task_queue
+    {
+        void* handle;
+    } nil_gate_task_queue;
+
+    nil_gate_task_queue nil_gate_task_queue_create(void);
+    // drops the pending tasks without running them, call it after the runner is replaced.
+    // the executors made from the queue stay valid (and drop their tasks) until unregistered.
+    void nil_gate_task_queue_destroy(nil_gate_task_queue queue);
+    // executor posting to the queue, to be passed to nil_gate_core_set_executor.
+    nil_gate_executor nil_gate_task_queue_executor(nil_gate_task_queue queue);
+    // runs the queued tasks on the calling thread. waits up to `timeout_ms` for a task when
+    // there is none. returns the number of tasks run.
+    size_t nil_gate_task_queue_run(nil_gate_task_queue queue, uint32_t timeout_ms);
+
+    // commit latency histograms (see nil::gate::probes::Latency), installed as a probe of a core.
+    //  - QUEUE: from nil_gate_core_commit to the runner starting to apply it
+    //  - COMMIT: from the start of a pass until its nodes are done
+    //  - LEVEL: per score level (async runner)
+    // NOLINTNEXTLINE(modernize-use-using)
+    typedef struct nil_gate_latency
+    {
+        void* handle;
+    } nil_gate_latency;
+
+    // NOLINTNEXTLINE(modernize-use-using)
+    typedef enum nil_gate_latency_kind
+    {
+        NIL_GATE_LATENCY_QUEUE = 0,
+        NIL_GATE_LATENCY_COMMIT = 1,
+        NIL_GATE_LATENCY_LEVEL = 2
+    } nil_gate_latency_kind;
+
+    // durations in nanoseconds. percentiles are the upper end of their bucket (within 1.6%).
+    // NOLINTNEXTLINE(modernize-use-using)
+    typedef struct nil_gate_latency_summary
+    {
+        uint64_t count;
+        uint64_t min;
+        uint64_t max;
+        uint64_t mean;
+        uint64_t p50;
+        uint64_t p90;
+        uint64_t p99;
+        uint64_t p999;
+        uint64_t p9999;
+    } nil_gate_latency_summary;
+
+    nil_gate_latency nil_gate_latency_create(void);
+    // uninstall it first (nil_gate_core_set_latency with a NULL handle).
+    void nil_gate_latency_destroy(nil_gate_latency latency);
+    // replaces the latency installed before, other probes of the core keep running
+    // (see nil::gate::probes::Multi). call while no commit is running.
+    void nil_gate_core_set_latency(nil_gate_core core, nil_gate_latency latency);
+    // number of score levels recorded so far (for NIL_GATE_LATENCY_LEVEL).
+    uint32_t nil_gate_latency_levels(nil_gate_latency latency);
+    // `level` is ignored except for NIL_GATE_LATENCY_LEVEL. all zeros when nothing was recorded.
+    nil_gate_latency_summary nil_gate_latency_get(
+        nil_gate_latency latency,
+        nil_gate_latency_kind kind,
+        uint32_t level
+    );
+    // `percentile` in [0, 100], e.g. 99.95.
+    uint64_t nil_gate_latency_percentile(
+        nil_gate_latency latency,
+        nil_gate_latency_kind kind,
+        uint32_t level,
+        double percentile
+    );
+    void nil_gate_latency_reset(nil_gate_latency latency);
+
     // NOLINTNEXTLINE(modernize-use-using)
     typedef struct nil_gate_graph
     {
@@ -133,10 +231,31 @@ extern "C"
         void* handle;
     } nil_gate_node;
 
+    // host-driven execution.
+    // the host owns the loop instead of being called back for every node:
+    //  - commits are queued and applied by nil_gate_core_next.
+    //  - native nodes run inside nil_gate_core_next.
+    //  - nodes registered with `exec == NULL` are returned by nil_gate_core_next,
+    //    a score level at a time. the host runs them (reading `inputs`, setting `outputs`)
+    //    and calls nil_gate_core_done before asking for the next batch.
+    //  - an empty batch means that there is nothing left to run.
+    // `exec == NULL` nodes do nothing under the other runners.
+    // NOLINTNEXTLINE(modernize-use-using)
+    typedef struct nil_gate_node_batch
+    {
+        size_t size;
+        const nil_gate_node_args* const* args;
+    } nil_gate_node_batch;
+
+    void nil_gate_core_set_runner_host(nil_gate_core core);
+    nil_gate_node_batch nil_gate_core_next(nil_gate_core core);
+    void nil_gate_core_done(nil_gate_core core);
+
     nil_gate_node nil_gate_graph_node(nil_gate_graph graph, nil_gate_node_info node_info);
 
     uint8_t nil_gate_node_output_size(nil_gate_node node);
     void nil_gate_node_outputs(nil_gate_node node, nil_gate_rport* outputs);
+    void nil_gate_node_set_affinity(nil_gate_node node, uint32_t tag);
 
     const void* nil_gate_rport_value(nil_gate_rport port);
     int nil_gate_rport_has_value(nil_gate_rport port);
@@ -144,6 +263,96 @@ extern "C"
     void nil_gate_mport_set_value(nil_gate_mport port, void* new_value);
     void nil_gate_mport_unset_value(nil_gate_mport port);
 
+    // built-in port kinds.
+    // values are stored and compared natively (no callback through `eq`).
+    //  - i64/f64/bool are stored inline in the port.
+    //  - blob is a copied byte buffer compared with memcmp.
+    // nil_gate_rport_value returns `const int64_t*`, `const double*`, `const int*`
+    // or `const nil_gate_blob*` respectively.
+    // nil_gate_mport_set_value / nil_gate_graph_port with these infos copy from the same
+    // pointer types, the pointee stays owned by the caller.
+    // use NIL_GATE_PORT_INFO(i64|f64|bool|blob) for node outputs of these kinds.
+
+    // NOLINTNEXTLINE(modernize-use-using)
+    typedef struct nil_gate_blob
+    {
+        size_t size;
+        const void* data;
+    } nil_gate_blob;
+
+    int nil_gate_port_eq_i64(const void* l, const void* r);
+    void nil_gate_port_destroy_i64(void* value);
+    int nil_gate_port_eq_f64(const void* l, const void* r);
+    void nil_gate_port_destroy_f64(void* value);
+    int nil_gate_port_eq_bool(const void* l, const void* r);
+    void nil_gate_port_destroy_bool(void* value);
+    int nil_gate_port_eq_blob(const void* l, const void* r);
+    void nil_gate_port_destroy_blob(void* value);
+
+    nil_gate_eport nil_gate_graph_port_i64(nil_gate_graph graph, int64_t initial_value);
+    nil_gate_eport nil_gate_graph_port_f64(nil_gate_graph graph, double initial_value);
+    nil_gate_eport nil_gate_graph_port_bool(nil_gate_graph graph, int initial_value);
+    nil_gate_eport nil_gate_graph_port_blob(nil_gate_graph graph, const void* data, size_t size);
+
+    void nil_gate_mport_set_i64(nil_gate_mport port, int64_t new_value);
+    void nil_gate_mport_set_f64(nil_gate_mport port, double new_value);
+    void nil_gate_mport_set_bool(nil_gate_mport port, int new_value);
+    void nil_gate_mport_set_blob(nil_gate_mport port, const void* data, size_t size);
+
+    // zero-copy blobs. the port borrows `data` instead of copying it.
+    // `release(owner)` is called once the value is replaced or the port is destroyed
+    // (also when the value is equal to the current one and is dropped right away).
+    // the bytes must not change while borrowed. they are read as a regular blob.
+    nil_gate_eport nil_gate_graph_port_blob_ref(
+        nil_gate_graph graph,
+        const void* data,
+        size_t size,
+        void* owner,
+        void (*release)(void*)
+    );
+    void nil_gate_mport_set_blob_ref(
+        nil_gate_mport port,
+        const void* data,
+        size_t size,
+        void* owner,
+        void (*release)(void*)
+    );
+    // `owner` of a borrowed blob created with `release`, NULL otherwise.
+    void* nil_gate_blob_owner(const nil_gate_blob* blob, void (*release)(void*));
+
+    // batch access. one call for `count` ports (parallel arrays), same rules as the single calls.
+    //  - setters stage every write and propagate them once (see nil::gate::Batch).
+    //    a NULL entry in `new_values` unsets the port.
+    //  - nil_gate_rports_values writes NULL for ports without a value.
+    //  - nil_gate_rports_changed compares each port's version against `versions`
+    //    (zero-initialize before the first call), stores the current version back,
+    //    flags `changed` (optional, can be NULL) and returns the number of changed ports.
+    void nil_gate_mports_set_values(
+        const nil_gate_mport* ports,
+        void* const* new_values,
+        size_t count
+    );
+    // same as nil_gate_mports_set_values. an entry with a non-NULL `owners[i]` is a
+    // `const nil_gate_blob*` that is borrowed instead of copied (see nil_gate_mport_set_blob_ref).
+    void nil_gate_mports_set_values_ref(
+        const nil_gate_mport* ports,
+        void* const* new_values,
+        void* const* owners,
+        void (*release)(void*),
+        size_t count
+    );
+    void nil_gate_mports_set_i64(const nil_gate_mport* ports, const int64_t* new_values, size_t count);
+    void nil_gate_mports_set_f64(const nil_gate_mport* ports, const double* new_values, size_t count);
+    void nil_gate_mports_set_bool(const nil_gate_mport* ports, const int* new_values, size_t count);
+
+    void nil_gate_rports_values(const nil_gate_rport* ports, const void** values, size_t count);
+    size_t nil_gate_rports_changed(
+        const nil_gate_rport* ports,
+        uint64_t* versions,
+        uint8_t* changed,
+        size_t count
+    );
+
     nil_gate_rport nil_gate_mport_as_input(nil_gate_mport port);
     nil_gate_rport nil_gate_rport_as_input(nil_gate_rport port);
     nil_gate_rport nil_gate_eport_as_input(nil_gate_eport port);
@@ -203,4 +412,23 @@ extern "C"
 #ifdef __cplusplus
 }
 
+    #include <span>
+
+namespace nil::gate::c
+{
+    /**
+     * @brief View of a blob value (from `nil_gate_rport_value` or node inputs) as `T`s.
+     *  No copy. Valid as long as the value is held by the port.
+     */
+    template <typename T>
+    std::span<const T> as_span(const void* blob_value)
+    {
+        if (blob_value == nullptr)
+        {
+            return {};
+        }
+        const auto* blob = static_cast<const nil_gate_blob*>(blob_value);
+        return {static_cast<const T*>(blob->data), blob->size / sizeof(T)};
+    }
+}
 #endif
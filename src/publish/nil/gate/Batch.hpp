@@ -0,0 +1,106 @@
+#pragma once
+
+#include "detail/Port.hpp"
+#include "ports/Mutable.hpp"
+
+#include <vector>
+
+namespace nil::gate
+{
+    /**
+     * @brief Stages writes to many ports with a single propagation pass.
+     *
+     *  Each write pends the port (and its downstream nodes) and applies the value.
+     *  The ports are kept pending until `flush()` (or destruction), so repeated writes
+     *  to the same port only replace the value and do not walk the graph again.
+     *
+     *  Ensure the following:
+     *   - only used inside core.post, core.apply, or
+     *   - used when the runner is not running
+     *
+     *  The instance can be kept alive across commits to reuse its staging buffer.
+     */
+    class Batch final
+    {
+    public:
+        Batch() = default;
+
+        explicit Batch(std::size_t capacity)
+        {
+            staged.reserve(capacity);
+        }
+
+        ~Batch() noexcept
+        {
+            flush();
+        }
+
+        Batch(Batch&&) = delete;
+        Batch(const Batch&) = delete;
+        Batch& operator=(Batch&&) = delete;
+        Batch& operator=(const Batch&) = delete;
+
+        template <typename T>
+        void set_value(ports::Mutable<T>* port, T new_data)
+        {
+            auto* p = static_cast<detail::Port<T>*>(port);
+            if (!p->is_equal(new_data))
+            {
+                stage(p);
+                p->assign(std::move(new_data));
+            }
+        }
+
+        template <typename T>
+        void unset_value(ports::Mutable<T>* port)
+        {
+            auto* p = static_cast<detail::Port<T>*>(port);
+            if (p->has_value())
+            {
+                stage(p);
+                p->unset();
+            }
+        }
+
+        /**
+         * @brief Mark all staged ports as done.
+         *  Downstream nodes can execute on the next commit.
+         */
+        void flush()
+        {
+            for (const auto& s : staged)
+            {
+                s.done(s.port);
+            }
+            staged.clear();
+        }
+
+    private:
+        struct Staged
+        {
+            void* port;
+            void (*done)(void*);
+        };
+
+        std::vector<Staged> staged;
+
+        template <typename T>
+        void stage(detail::Port<T>* port)
+        {
+            // pend stops at already pending ports/nodes.
+            // a port only needs to be recorded the first time it is written.
+            // uninitialized ports start as pending but without a value.
+            if (!port->is_pending() || !port->has_value())
+            {
+                port->pend();
+                staged.push_back({port, &impl_done<T>});
+            }
+        }
+
+        template <typename T>
+        static void impl_done(void* port)
+        {
+            static_cast<detail::Port<T>*>(port)->done();
+        }
+    };
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace nil::gate
+{
+    template <typename Signature, std::size_t Capacity = 4 * sizeof(void*)>
+    class Callable;
+
+    /**
+     * @brief Move-only type-erased callable with inline storage.
+     *  Callables that fit in `Capacity` bytes (and are nothrow movable) are stored inline
+     *  and never allocate. Bigger callables fall back to a single heap allocation.
+     *
+     * @tparam R        - return type
+     * @tparam A        - argument types
+     * @tparam Capacity - size of the inline storage in bytes
+     */
+    template <typename R, typename... A, std::size_t Capacity>
+    class Callable<R(A...), Capacity> final
+    {
+    public:
+        Callable() noexcept = default;
+
+        // NOLINTNEXTLINE(hicpp-explicit-conversions)
+        Callable(std::nullptr_t) noexcept
+        {
+        }
+
+        template <typename F>
+            requires(!std::is_same_v<std::decay_t<F>, Callable>
+                     && std::is_invocable_r_v<R, std::decay_t<F>&, A...>)
+        // NOLINTNEXTLINE(hicpp-explicit-conversions)
+        Callable(F&& f)
+        {
+            using T = std::decay_t<F>;
+            if constexpr (is_inline<T>)
+            {
+                ::new (static_cast<void*>(storage)) T(std::forward<F>(f));
+                vtable = &inline_vtable<T>;
+            }
+            else
+            {
+                ::new (static_cast<void*>(storage)) T*(new T(std::forward<F>(f))); // NOLINT
+                vtable = &heap_vtable<T>;
+            }
+        }
+
+        ~Callable() noexcept
+        {
+            reset();
+        }
+
+        Callable(Callable&& o) noexcept
+            : vtable(std::exchange(o.vtable, nullptr))
+        {
+            if (vtable != nullptr)
+            {
+                vtable->move(o.storage, storage);
+            }
+        }
+
+        Callable& operator=(Callable&& o) noexcept
+        {
+            if (this != &o)
+            {
+                reset();
+                vtable = std::exchange(o.vtable, nullptr);
+                if (vtable != nullptr)
+                {
+                    vtable->move(o.storage, storage);
+                }
+            }
+            return *this;
+        }
+
+        Callable& operator=(std::nullptr_t) noexcept
+        {
+            reset();
+            return *this;
+        }
+
+        Callable(const Callable&) = delete;
+        Callable& operator=(const Callable&) = delete;
+
+        R operator()(A... args)
+        {
+            return vtable->call(storage, std::forward<A>(args)...);
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return vtable != nullptr;
+        }
+
+        template <typename F>
+        static constexpr bool is_inline             //
+            = sizeof(F) <= Capacity                 //
+            && alignof(F) <= alignof(std::max_align_t) //
+            && std::is_nothrow_move_constructible_v<F>;
+
+    private:
+        struct VTable
+        {
+            R (*call)(void*, A&&...);
+            // move constructs into `to` and destroys `from`
+            void (*move)(void* from, void* to) noexcept;
+            void (*destroy)(void*) noexcept;
+        };
+
+        template <typename T>
+        static constexpr VTable inline_vtable = {
+            .call = [](void* s, A&&... args) -> R
+            { return std::invoke(*static_cast<T*>(s), std::forward<A>(args)...); },
+            .move =
+                [](void* from, void* to) noexcept
+            {
+                ::new (to) T(std::move(*static_cast<T*>(from)));
+                static_cast<T*>(from)->~T();
+            },
+            .destroy = [](void* s) noexcept { static_cast<T*>(s)->~T(); }
+        };
+
+        template <typename T>
+        static constexpr VTable heap_vtable = {
+            .call = [](void* s, A&&... args) -> R
+            { return std::invoke(**static_cast<T**>(s), std::forward<A>(args)...); },
+            .move = [](void* from, void* to) noexcept
+            { ::new (to) T*(*static_cast<T**>(from)); },
+            .destroy = [](void* s) noexcept { delete *static_cast<T**>(s); } // NOLINT
+        };
+
+        void reset() noexcept
+        {
+            if (vtable != nullptr)
+            {
+                std::exchange(vtable, nullptr)->destroy(storage);
+            }
+        }
+
+        const VTable* vtable = nullptr;
+        alignas(std::max_align_t) std::byte storage[Capacity < sizeof(void*) ? sizeof(void*) : Capacity]; // NOLINT
+    };
+}
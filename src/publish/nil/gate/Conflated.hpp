@@ -0,0 +1,227 @@
+#pragma once
+
+#include "ports/Mutable.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace nil::gate
+{
+    template <typename T>
+    class Conflated;
+}
+
+namespace nil::gate::detail
+{
+    class IConflated
+    {
+    public:
+        IConflated() = default;
+        virtual ~IConflated() noexcept = default;
+
+        IConflated(IConflated&&) noexcept = delete;
+        IConflated& operator=(IConflated&&) noexcept = delete;
+
+        IConflated(const IConflated&) = delete;
+        IConflated& operator=(const IConflated&) = delete;
+
+        // called with the queue locked. moves the latest staged value to the consumer side.
+        virtual void swap() = 0;
+        // called by the consumer without the lock. applies the value to the port.
+        virtual void apply() = 0;
+
+        bool queued = false;
+    };
+
+    /**
+     * @brief Owns the conflated slots of a Core and the list of slots written since the
+     *  last commit. Producers only touch the list while holding the lock.
+     *  The list is reserved to the number of slots so staging never allocates.
+     *  Removed slots are destroyed by the consumer, never while their values are applied.
+     */
+    class ConflatedQueue final
+    {
+    public:
+        ConflatedQueue() = default;
+        ~ConflatedQueue() noexcept = default;
+
+        ConflatedQueue(ConflatedQueue&&) = delete;
+        ConflatedQueue(const ConflatedQueue&) = delete;
+        ConflatedQueue& operator=(ConflatedQueue&&) = delete;
+        ConflatedQueue& operator=(const ConflatedQueue&) = delete;
+
+        template <typename T>
+        Conflated<T>* add(ports::Mutable<T>* port)
+        {
+            auto slot = std::make_unique<Conflated<T>>(this, port);
+            auto* ptr = slot.get();
+
+            auto lock = std::unique_lock(mutex);
+            slots.emplace_back(std::move(slot));
+            // `draining` is only touched by the consumer, it is sized in apply
+            dirty.reserve(slots.size());
+            return ptr;
+        }
+
+        // the slot is dropped (with its staged value) at the start of the next apply
+        void remove(IConflated* slot)
+        {
+            auto lock = std::unique_lock(mutex);
+            removed.push_back(slot);
+        }
+
+        template <typename Fn>
+        void stage(IConflated* slot, Fn&& fn)
+        {
+            auto lock = std::unique_lock(mutex);
+            fn();
+            if (!slot->queued)
+            {
+                slot->queued = true;
+                dirty.push_back(slot);
+            }
+        }
+
+        // only called by the runner (single consumer)
+        void apply()
+        {
+            {
+                auto lock = std::unique_lock(mutex);
+                for (auto* slot : removed)
+                {
+                    if (slot->queued)
+                    {
+                        std::erase(dirty, slot);
+                    }
+                    std::erase_if(slots, [slot](const auto& s) { return s.get() == slot; });
+                }
+                removed.clear();
+
+                if (dirty.empty())
+                {
+                    return;
+                }
+                // empty here. after the swap it becomes `dirty`, reserved for every slot.
+                draining.reserve(slots.size());
+                for (auto* slot : dirty)
+                {
+                    slot->queued = false;
+                    slot->swap();
+                }
+                std::swap(dirty, draining);
+            }
+
+            for (auto* slot : draining)
+            {
+                slot->apply();
+            }
+            draining.clear();
+        }
+
+    private:
+        std::mutex mutex;
+        std::vector<std::unique_ptr<IConflated>> slots;
+        std::vector<IConflated*> dirty;
+        std::vector<IConflated*> draining;
+        std::vector<IConflated*> removed;
+    };
+}
+
+namespace nil::gate
+{
+    /**
+     * @brief Conflating write handle of a port returned by Core::conflate.
+     *  Only the latest value written between commits is applied to the port.
+     *  Safe to call from any thread. Staging a value does not allocate.
+     *
+     *  The handle is owned by the Core. Release it with Core::remove before removing its port,
+     *  a value staged for a removed port would be applied to a dangling port otherwise.
+     *
+     * @tparam T
+     */
+    template <typename T>
+    class Conflated final: public detail::IConflated
+    {
+    public:
+        Conflated(detail::ConflatedQueue* init_queue, ports::Mutable<T>* init_port)
+            : queue(init_queue)
+            , port(init_port)
+        {
+        }
+
+        ~Conflated() noexcept override = default;
+
+        Conflated(Conflated&&) noexcept = delete;
+        Conflated& operator=(Conflated&&) noexcept = delete;
+
+        Conflated(const Conflated&) = delete;
+        Conflated& operator=(const Conflated&) = delete;
+
+        void set_value(T new_data)
+        {
+            queue->stage(
+                this,
+                [&]()
+                {
+                    staged = std::move(new_data);
+                    staged_action = EAction::Set;
+                }
+            );
+        }
+
+        void unset_value()
+        {
+            queue->stage(
+                this,
+                [&]()
+                {
+                    staged.reset();
+                    staged_action = EAction::Unset;
+                }
+            );
+        }
+
+    private:
+        enum class EAction
+        {
+            None,
+            Set,
+            Unset
+        };
+
+        detail::ConflatedQueue* queue;
+        ports::Mutable<T>* port;
+
+        std::optional<T> staged;
+        EAction staged_action = EAction::None;
+
+        std::optional<T> current;
+        EAction current_action = EAction::None;
+
+        void swap() override
+        {
+            std::swap(staged, current);
+            current_action = std::exchange(staged_action, EAction::None);
+        }
+
+        void apply() override
+        {
+            switch (current_action)
+            {
+                case EAction::Set:
+                    port->set_value(std::move(*current));
+                    break;
+                case EAction::Unset:
+                    port->unset_value();
+                    break;
+                case EAction::None:
+                    break;
+            }
+            current_action = EAction::None;
+        }
+    };
+}
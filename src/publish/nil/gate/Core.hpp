@@ -1,12 +1,12 @@
 #pragma once
 
+#include "Conflated.hpp"
 #include "Graph.hpp"
 #include "IRunner.hpp"
 
+#include "detail/ChangeQueue.hpp"
 #include "detail/traits/node.hpp"
 
-#include <nil/xalt/fn_call.hpp>
-
 namespace nil::gate
 {
     class Core final
@@ -25,11 +25,14 @@ namespace nil::gate
         Core(const Core&) = delete;
         Core& operator=(const Core&) = delete;
 
+        /**
+         * Schedule a change to be applied on commit.
+         * Safe to call from any thread. Posting does not block.
+         */
         template <typename Callable>
         void post(Callable&& callable)
         {
-            changes.push_back([callable = std::forward<Callable>(callable)](Graph& g) mutable
-                              { nil::xalt::fn_call(callable, g); });
+            changes.push(std::forward<Callable>(callable));
         }
 
         template <typename Callable>
@@ -39,9 +42,38 @@ namespace nil::gate
             commit();
         }
 
+        /**
+         * Create a conflating write handle for the port.
+         * Values written to the handle are applied on the next commit, before posted changes.
+         * Only the latest value per port survives until then.
+         */
+        template <typename T>
+        Conflated<T>* conflate(ports::Mutable<T>* port)
+        {
+            return conflated.add(port);
+        }
+
+        template <typename T>
+        Conflated<T>* conflate(ports::External<T>* port)
+        {
+            return conflated.add(port->to_direct());
+        }
+
+        /**
+         * Release a handle returned by `conflate`, dropping its value if one is staged.
+         * Safe to call from any thread. The handle must not be used afterwards.
+         * Call it before (or in the same change as) the removal of the port from the graph.
+         */
+        template <typename T>
+        void remove(Conflated<T>* handle)
+        {
+            conflated.remove(handle);
+        }
+
         /**
          * Commit all of the changes to the graph.
          * Changes are scheduled by mutating the ports through their set_value method.
+         * Takes the changes posted before this call, later posts wait for the next commit.
          */
         void commit()
         {
@@ -49,16 +81,15 @@ namespace nil::gate
             {
                 return;
             }
+            if (auto* p = graph.probe; p != nullptr)
+            {
+                p->commit_requested();
+            }
             runner->run(
-                [this, fns = std::move(changes)]()
+                [this, batch = changes.take()]() mutable
                 {
-                    for (const auto& fn : fns)
-                    {
-                        if (fn)
-                        {
-                            fn(graph);
-                        }
-                    }
+                    conflated.apply();
+                    batch.apply(graph);
                     return graph.sort();
                 }
             );
@@ -70,6 +101,10 @@ namespace nil::gate
         void set_runner(IRunner* new_runner)
         {
             runner = new_runner;
+            if (runner != nullptr)
+            {
+                runner->set_probe(graph.probe);
+            }
         }
 
         IRunner* get_runner() const
@@ -77,10 +112,29 @@ namespace nil::gate
             return runner;
         }
 
+        /**
+         * Install instrumentation hooks on every node, current and future (see `probes::Stats`).
+         * `nullptr` (default) disables them. Call while no commit is running.
+         */
+        void set_probe(IProbe* new_probe)
+        {
+            graph.set_probe(new_probe);
+            if (runner != nullptr)
+            {
+                runner->set_probe(new_probe);
+            }
+        }
+
+        IProbe* get_probe() const
+        {
+            return graph.probe;
+        }
+
     private:
         Graph graph;
         IRunner* runner = nullptr;
-        std::vector<std::function<void(Graph&)>> changes;
+        detail::ChangeQueue changes;
+        detail::ConflatedQueue conflated;
     };
 
     template <typename TO, typename FROM>
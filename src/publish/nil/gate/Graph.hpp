@@ -92,6 +92,7 @@ namespace nil::gate
                 std::move(instance),
                 std::move(input_ports)
             );
+            n->set_probe(probe);
             return static_cast<typename detail::Node<T>::base_t*>(
                 owned_nodes.emplace_back(n.release())
             );
@@ -103,6 +104,7 @@ namespace nil::gate
         {
             need_to_sort = true;
             auto n = std::make_unique<detail::Node<T>>(core, std::move(instance), inputs_t<T>());
+            n->set_probe(probe);
             return static_cast<typename detail::Node<T>::base_t*>(
                 owned_nodes.emplace_back(n.release())
             );
@@ -113,6 +115,7 @@ namespace nil::gate
         {
             need_to_sort = true;
             auto n = std::make_unique<detail::UNode<T>>(core, std::move(info));
+            n->set_probe(probe);
             return static_cast<typename detail::UNode<T>::base_t*>(
                 owned_nodes.emplace_back(n.release())
             );
@@ -149,6 +152,14 @@ namespace nil::gate
 
         /// starting from this point - misc
 
+        /**
+         * @brief Nodes owned by the graph, for introspection (see Topology).
+         */
+        std::span<INode* const> nodes() const
+        {
+            return owned_nodes;
+        }
+
         void remove(INode* node)
         {
             remove(owned_nodes, node);
@@ -176,10 +187,20 @@ namespace nil::gate
 
     private:
         Core* core;
+        IProbe* probe = nullptr;
         std::vector<INode*> owned_nodes;
         std::vector<EPort*> external_ports;
         bool need_to_sort = true;
 
+        void set_probe(IProbe* new_probe)
+        {
+            probe = new_probe;
+            for (auto* n : owned_nodes)
+            {
+                n->set_probe(probe);
+            }
+        }
+
         auto sort() -> std::span<INode* const>
         {
             if (need_to_sort)
@@ -1,6 +1,9 @@
 #pragma once
 
+#include "IProbe.hpp"
+
 #include <cstdint>
+#include <vector>
 
 namespace nil::gate
 {
@@ -36,6 +39,57 @@ namespace nil::gate
         virtual std::uint32_t score() const = 0;
         virtual void detach_in(IPort* port) = 0;
 
+        enum class EInput
+        {
+            Direct,
+            Convert, // through a traits::compatibility adapter
+            Lens     // field of the port (ports::Lens)
+        };
+
+        struct Input
+        {
+            const IPort* port = nullptr;   // port read from (before conversion), nullptr if removed
+            const INode* source = nullptr; // node producing the port, nullptr when set from outside
+            EInput kind = EInput::Direct;
+            bool passive = false;
+        };
+
+        /**
+         * @brief Connections of the inputs, in order. For introspection (see Topology).
+         */
+        virtual std::vector<Input> describe_inputs() const
+        {
+            return {};
+        }
+
+        /**
+         * @brief Thread affinity tag. 0 (default) runs on any thread.
+         *  Runners that support it execute tagged nodes on the executor registered for the tag
+         *  (see runners::AsyncT::set_executor).
+         */
+        std::uint32_t affinity() const noexcept
+        {
+            return affinity_tag;
+        }
+
+        void set_affinity(std::uint32_t tag) noexcept
+        {
+            affinity_tag = tag;
+        }
+
+        /**
+         * @brief Instrumentation hooks of the node. Set through Core::set_probe.
+         */
+        IProbe* probe() const noexcept
+        {
+            return node_probe;
+        }
+
+        void set_probe(IProbe* new_probe) noexcept
+        {
+            node_probe = new_probe;
+        }
+
     protected:
         enum class ENodeState
         {
@@ -48,5 +102,9 @@ namespace nil::gate
             Stale = 0b0001,
             Changed = 0b0010
         };
+
+    private:
+        std::uint32_t affinity_tag = 0;
+        IProbe* node_probe = nullptr;
     };
 }
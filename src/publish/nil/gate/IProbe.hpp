@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstdint>
+
+namespace nil::gate
+{
+    class INode;
+    class IPort;
+
+    /**
+     * @brief Instrumentation hooks. Installed with Core::set_probe, none by default.
+     *  Every hook defaults to doing nothing, override the ones of interest.
+     *  Hooks of nodes run on the thread that executes the node and can be called
+     *  concurrently by the async runners.
+     */
+    struct IProbe
+    {
+        IProbe() = default;
+        virtual ~IProbe() noexcept = default;
+
+        IProbe(IProbe&&) noexcept = default;
+        IProbe& operator=(IProbe&&) noexcept = default;
+
+        IProbe(const IProbe&) = default;
+        IProbe& operator=(const IProbe&) = default;
+
+        /**
+         * @brief Around the execution of a node.
+         *  Pairs nest on one thread, a node may commit (and execute other nodes) inline,
+         *  exec_end always closes the innermost exec_begin. Same for commit_begin/commit_end.
+         */
+        virtual void exec_begin(const INode& /* node */)
+        {
+        }
+
+        virtual void exec_end(const INode& /* node */)
+        {
+        }
+
+        /**
+         * @brief Asked before executing `node`. Returning true skips this execution,
+         *  the outputs of the node keep their previous values (load shedding).
+         *  The node stays pending and is asked again on the following commits.
+         */
+        virtual bool shed(const INode& /* node */)
+        {
+            return false;
+        }
+
+        /**
+         * @brief Node was ready but none of its inputs changed (early cutoff).
+         */
+        virtual void skipped(const INode& /* node */)
+        {
+        }
+
+        /**
+         * @brief An output of `node` was compared against a new value.
+         */
+        virtual void compared(const INode& /* node */, bool /* equal */)
+        {
+        }
+
+        /**
+         * @brief `port`, an input of `node`, changed and will trigger its execution.
+         *  `source` is the node that produced the value, `nullptr` for the ports set from outside.
+         */
+        virtual void input_changed(
+            const INode& /* node */,
+            const IPort& /* port */,
+            const INode* /* source */
+        )
+        {
+        }
+
+        /**
+         * @brief Core::commit was called, on the calling thread.
+         */
+        virtual void commit_requested()
+        {
+        }
+
+        /**
+         * @brief Runner started applying a commit (the changes posted before Core::commit).
+         *  Commits merged by the runner are reported once.
+         */
+        virtual void commit_begin()
+        {
+        }
+
+        /**
+         * @brief Every node of the commit is done, or a newer commit took over.
+         *  Called on the thread that called commit_begin.
+         */
+        virtual void commit_end()
+        {
+        }
+
+        /**
+         * @brief Node was handed to another thread for execution (async runners).
+         *  Called on the scheduling thread, before exec_begin/skipped.
+         */
+        virtual void queued(const INode& /* node */)
+        {
+        }
+
+        /**
+         * @brief Around the nodes of one score level (async runners).
+         *  Called on the scheduling thread, level_end once every node of the level is done
+         *  or a newer commit took over.
+         */
+        virtual void level_begin(std::uint32_t /* score */)
+        {
+        }
+
+        virtual void level_end(std::uint32_t /* score */)
+        {
+        }
+    };
+}
@@ -1,8 +1,9 @@
 #pragma once
 
+#include "Callable.hpp"
 #include "INode.hpp"
+#include "IProbe.hpp"
 
-#include <functional>
 #include <span>
 
 namespace nil::gate
@@ -23,8 +24,24 @@ namespace nil::gate
         /**
          * @param apply_changes - a callable that is intended to apply the changes on the ports.
          *                      - the changes are mainly from Port::set_value.
-         * @param nodes - these nodes are alive as long as the Core object is alive.
+         *                      - returns the nodes that are alive as long as the Core object is alive.
          */
-        virtual void run(std::function<std::span<INode* const>()> apply_changes) = 0;
+        virtual void run(Callable<std::span<INode* const>()> apply_changes) = 0;
+
+        /**
+         * @brief Hooks for commit boundaries and scheduling. Set through Core::set_probe.
+         */
+        IProbe* probe() const noexcept
+        {
+            return runner_probe;
+        }
+
+        void set_probe(IProbe* new_probe) noexcept
+        {
+            runner_probe = new_probe;
+        }
+
+    private:
+        IProbe* runner_probe = nullptr;
     };
 }
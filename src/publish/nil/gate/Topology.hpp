@@ -0,0 +1,203 @@
+#pragma once
+
+#include "Graph.hpp"
+#include "probes/Stats.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace nil::gate
+{
+    /**
+     * @brief Shape of a graph. Build with `Topology::of(graph)` inside Core::apply/post.
+     *  Edges are counted per input, a node reading the same port twice counts twice.
+     */
+    struct Topology
+    {
+        struct Edge
+        {
+            const INode* from = nullptr; // nullptr for ports set from outside
+            const INode* to = nullptr;
+            const IPort* port = nullptr;
+            INode::EInput kind = INode::EInput::Direct;
+            bool passive = false;
+        };
+
+        std::size_t node_count = 0;
+        std::uint32_t depth = 0;         // highest score
+        std::vector<std::size_t> widths; // nodes per score, the parallelism of each level
+        std::vector<std::size_t> fan_in; // [n]: nodes with n inputs
+        std::vector<std::size_t> fan_out; // [n]: nodes with n consumers
+        std::vector<Edge> edges;          // every input of every node
+        std::vector<Edge> adapters;       // edges going through a Convert/Lens adapter
+
+        static Topology of(const Graph& graph)
+        {
+            Topology t;
+            const auto nodes = graph.nodes();
+            t.node_count = nodes.size();
+
+            std::unordered_map<const INode*, std::size_t> consumers;
+            for (const auto* node : nodes)
+            {
+                const auto score = node->score();
+                t.depth = std::max(t.depth, score);
+                add(t.widths, score);
+
+                const auto inputs = node->describe_inputs();
+                add(t.fan_in, inputs.size());
+                consumers.try_emplace(node, 0);
+                for (const auto& i : inputs)
+                {
+                    const Edge edge{
+                        .from = i.source,
+                        .to = node,
+                        .port = i.port,
+                        .kind = i.kind,
+                        .passive = i.passive,
+                    };
+                    if (i.source != nullptr)
+                    {
+                        ++consumers[i.source];
+                    }
+                    if (i.kind != INode::EInput::Direct)
+                    {
+                        t.adapters.push_back(edge);
+                    }
+                    t.edges.push_back(edge);
+                }
+            }
+            for (const auto* node : nodes)
+            {
+                add(t.fan_out, consumers[node]);
+            }
+            return t;
+        }
+
+    private:
+        static void add(std::vector<std::size_t>& histogram, std::size_t index)
+        {
+            if (histogram.size() <= index)
+            {
+                histogram.resize(index + 1);
+            }
+            ++histogram[index];
+        }
+    };
+
+    /**
+     * @brief Writes the graph in Graphviz DOT (`dot -Tsvg`), nodes ranked by score.
+     *  With `stats`, nodes are labeled with their execution counts and times
+     *  and colored by their share of the total execution time (white to red).
+     *  Dashed edges are passive inputs, labeled edges go through an adapter.
+     */
+    inline void write_dot(std::ostream& os, const Graph& graph, const probes::Stats* stats = nullptr)
+    {
+        const auto nodes = graph.nodes();
+        const auto topology = Topology::of(graph);
+
+        std::unordered_map<const INode*, probes::Stats::Node> timings;
+        std::chrono::nanoseconds max_time{0};
+        if (stats != nullptr)
+        {
+            for (const auto* node : nodes)
+            {
+                const auto s = stats->get(node);
+                max_time = std::max(max_time, s.total_time);
+                timings.emplace(node, s);
+            }
+        }
+
+        const auto id = [](const void* p)
+        {
+            std::array<char, 32> buffer = {};
+            std::snprintf(buffer.data(), buffer.size(), "%p", p);
+            return std::string(buffer.data());
+        };
+
+        os << "digraph nil_gate {\n";
+        os << "  rankdir=LR;\n";
+        os << "  node [shape=box, style=filled, fillcolor=\"#ffffff\"];\n";
+
+        std::vector<std::vector<const INode*>> ranks(topology.widths.size());
+        for (const auto* node : nodes)
+        {
+            ranks[node->score()].push_back(node);
+            os << "  \"n" << id(node) << "\" [label=\"node@" << id(node) << "\\nscore "
+               << node->score();
+            if (stats != nullptr)
+            {
+                const auto& s = timings[node];
+                const auto us = double(s.total_time.count()) / 1000.0;
+                os << "\\nexec " << s.exec_count << ", skip " << s.skip_count << "\\n" << us
+                   << "us (max " << double(s.max_time.count()) / 1000.0 << "us)";
+                if (max_time.count() > 0)
+                {
+                    const auto share = double(s.total_time.count()) / double(max_time.count());
+                    std::array<char, 8> color = {};
+                    const auto c = int(255.0 * (1.0 - share));
+                    std::snprintf(color.data(), color.size(), "#ff%02x%02x", c, c);
+                    os << "\", fillcolor=\"" << color.data();
+                }
+            }
+            os << "\"];\n";
+        }
+
+        for (const auto& rank : ranks)
+        {
+            if (rank.empty())
+            {
+                continue;
+            }
+            os << "  { rank=same;";
+            for (const auto* node : rank)
+            {
+                os << " \"n" << id(node) << '"';
+            }
+            os << " }\n";
+        }
+
+        std::unordered_map<const IPort*, bool> feeds;
+        for (const auto& e : topology.edges)
+        {
+            if (e.port == nullptr)
+            {
+                continue;
+            }
+            if (e.from == nullptr && !std::exchange(feeds[e.port], true))
+            {
+                os << "  \"p" << id(e.port) << "\" [shape=ellipse, label=\"port@" << id(e.port)
+                   << "\"];\n";
+            }
+
+            os << "  \"" << (e.from == nullptr ? "p" + id(e.port) : "n" + id(e.from)) << "\" -> \"n"
+               << id(e.to) << '"';
+            const char* label = e.kind == INode::EInput::Convert ? "convert"
+                : e.kind == INode::EInput::Lens                  ? "lens"
+                                                                 : nullptr;
+            if (label != nullptr || e.passive)
+            {
+                os << " [";
+                if (label != nullptr)
+                {
+                    os << "label=\"" << label << "\", color=\"#1f77b4\"";
+                }
+                if (e.passive)
+                {
+                    os << (label != nullptr ? ", " : "") << "style=dashed";
+                }
+                os << ']';
+            }
+            os << ";\n";
+        }
+        os << "}\n";
+    }
+}
@@ -0,0 +1,281 @@
+#pragma once
+
+#include <nil/xalt/fn_call.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace nil::gate
+{
+    class Graph;
+}
+
+namespace nil::gate::detail
+{
+    /**
+     * @brief Multi-producer single-consumer queue of changes posted to the Core.
+     *  Producers push with a lock-free CAS on the list head from any thread.
+     *  `take` detaches the whole list with a single exchange and restores posting order.
+     *  The returned Batch owns its changes until it is applied or destroyed.
+     *  Each change is a single allocation holding the callable inline.
+     *  Changes that fit in `block_size` bytes are recycled through a free list, so posting
+     *  does not allocate once the queue is warmed up.
+     */
+    class ChangeQueue final
+    {
+    public:
+        ChangeQueue() = default;
+
+        static constexpr std::size_t block_size = 64;
+
+        ~ChangeQueue() noexcept
+        {
+            auto* change = head.exchange(nullptr, std::memory_order_acquire);
+            while (change != nullptr)
+            {
+                destroy(std::exchange(change, change->next));
+            }
+
+            auto* block = free_head.exchange(nullptr, std::memory_order_acquire);
+            while (block != nullptr)
+            {
+                ::operator delete(std::exchange(block, block->next));
+            }
+        }
+
+        ChangeQueue(ChangeQueue&&) = delete;
+        ChangeQueue(const ChangeQueue&) = delete;
+        ChangeQueue& operator=(ChangeQueue&&) = delete;
+        ChangeQueue& operator=(const ChangeQueue&) = delete;
+
+        template <typename Callable>
+        void push(Callable&& callable)
+        {
+            using change_t = Change<std::decay_t<Callable>>;
+
+            IChange* change = nullptr;
+            if constexpr (sizeof(change_t) <= block_size
+                          && alignof(change_t) <= alignof(std::max_align_t))
+            {
+                void* block = acquire();
+                try
+                {
+                    change = ::new (block) change_t(std::forward<Callable>(callable));
+                }
+                catch (...)
+                {
+                    release(block);
+                    throw;
+                }
+                change->pooled = true;
+            }
+            else
+            {
+                change = new change_t(std::forward<Callable>(callable)); // NOLINT
+            }
+
+            change->next = head.load(std::memory_order_relaxed);
+            while (!head.compare_exchange_weak(
+                change->next,
+                change,
+                std::memory_order_release,
+                std::memory_order_relaxed
+            ))
+            {
+            }
+        }
+
+        class Batch;
+
+        /**
+         * @brief Detach the changes posted so far, in posting order.
+         */
+        Batch take();
+
+    private:
+        struct IChange
+        {
+            IChange() = default;
+            virtual ~IChange() noexcept = default;
+
+            IChange(IChange&&) noexcept = delete;
+            IChange& operator=(IChange&&) noexcept = delete;
+
+            IChange(const IChange&) = delete;
+            IChange& operator=(const IChange&) = delete;
+
+            virtual void call(Graph& graph) = 0;
+
+            IChange* next = nullptr;
+            bool pooled = false;
+        };
+
+        template <typename Callable>
+        struct Change final: IChange
+        {
+            explicit Change(Callable init_callable)
+                : callable(std::move(init_callable))
+            {
+            }
+
+            void call(Graph& graph) override
+            {
+                nil::xalt::fn_call(callable, graph);
+            }
+
+            Callable callable;
+        };
+
+        struct Block
+        {
+            Block* next = nullptr;
+        };
+
+        std::atomic<IChange*> head = nullptr;
+
+        // blocks are pushed back when their change is destroyed.
+        // `popping` allows a single producer to pop at a time which avoids ABA on the free list.
+        // a producer that loses the race allocates a new block instead of waiting.
+        std::atomic<Block*> free_head = nullptr;
+        std::atomic_flag popping;
+
+        void* acquire()
+        {
+            if (!popping.test_and_set(std::memory_order_acquire))
+            {
+                auto* block = free_head.load(std::memory_order_acquire);
+                while (block != nullptr
+                       && !free_head.compare_exchange_weak(
+                           block,
+                           block->next,
+                           std::memory_order_acquire,
+                           std::memory_order_acquire
+                       ))
+                {
+                }
+                popping.clear(std::memory_order_release);
+                if (block != nullptr)
+                {
+                    return block;
+                }
+            }
+            return ::operator new(block_size);
+        }
+
+        void release(void* memory) noexcept
+        {
+            auto* block = ::new (memory) Block();
+            block->next = free_head.load(std::memory_order_relaxed);
+            while (!free_head.compare_exchange_weak(
+                block->next,
+                block,
+                std::memory_order_release,
+                std::memory_order_relaxed
+            ))
+            {
+            }
+        }
+
+        static void discard(IChange* change) noexcept
+        {
+            if (change->pooled)
+            {
+                change->~IChange();
+                ::operator delete(change);
+            }
+            else
+            {
+                delete change; // NOLINT
+            }
+        }
+
+        void destroy(IChange* change) noexcept
+        {
+            if (change->pooled)
+            {
+                change->~IChange();
+                release(change);
+            }
+            else
+            {
+                delete change; // NOLINT
+            }
+        }
+    };
+
+    /**
+     * @brief Changes detached from the queue by ChangeQueue::take, applied in posting order.
+     */
+    class ChangeQueue::Batch final
+    {
+    public:
+        Batch() = default;
+
+        // does not touch the queue, a runner may drop its pending commits after the Core is gone
+        ~Batch() noexcept
+        {
+            while (head != nullptr)
+            {
+                discard(std::exchange(head, head->next));
+            }
+        }
+
+        Batch(Batch&& o) noexcept
+            : queue(std::exchange(o.queue, nullptr))
+            , head(std::exchange(o.head, nullptr))
+        {
+        }
+
+        Batch& operator=(Batch&& o) noexcept = delete;
+        Batch(const Batch&) = delete;
+        Batch& operator=(const Batch&) = delete;
+
+        void apply(Graph& graph)
+        {
+            while (head != nullptr)
+            {
+                auto* current = std::exchange(head, head->next);
+                try
+                {
+                    current->call(graph);
+                }
+                catch (...)
+                {
+                    // the remaining changes are dropped by the destructor
+                    queue->destroy(current);
+                    throw;
+                }
+                queue->destroy(current);
+            }
+        }
+
+    private:
+        friend class ChangeQueue;
+
+        Batch(ChangeQueue* init_queue, IChange* init_head)
+            : queue(init_queue)
+            , head(init_head)
+        {
+        }
+
+        ChangeQueue* queue = nullptr;
+        IChange* head = nullptr;
+    };
+
+    inline ChangeQueue::Batch ChangeQueue::take()
+    {
+        IChange* reversed = nullptr;
+        auto* change = head.exchange(nullptr, std::memory_order_acquire);
+        while (change != nullptr)
+        {
+            auto* next = change->next;
+            change->next = reversed;
+            reversed = change;
+            change = next;
+        }
+        return {this, reversed};
+    }
+}
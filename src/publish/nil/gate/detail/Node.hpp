@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../INode.hpp"
+#include "sdt.hpp"
 #include "traits/node.hpp"
 
 #include <nil/xalt/checks.hpp>
@@ -91,10 +92,26 @@ namespace nil::gate::detail
             {
                 if (!o.is_equal(v))
                 {
-                    o.set(std::forward<U>(v));
+                    o.assign(std::forward<U>(v));
                 }
             };
             using return_type = xalt::fn_sign<T>::return_type;
+            auto* const p = this->probe();
+            if (p != nullptr)
+            {
+                if (p->shed(*this))
+                {
+                    shed = true;
+                    return;
+                }
+                p->exec_begin(*this);
+            }
+            if (std::exchange(outputs_released, false))
+            {
+                // released by a shed execution, the nodes reading them have to wait again
+                std::apply([](auto&... outs) { (outs.pend(), ...); }, req_outputs);
+            }
+            NIL_GATE_SDT1(exec_begin, this);
             if constexpr (std::is_same_v<return_type, void>)
             {
                 call(typename input_t::make_index_sequence());
@@ -110,6 +127,11 @@ namespace nil::gate::detail
             {
                 setter(get<0>(req_outputs), call(typename input_t::make_index_sequence()));
             }
+            NIL_GATE_SDT1(exec_end, this);
+            if (p != nullptr)
+            {
+                p->exec_end(*this);
+            }
         }
 
         void pend() override
@@ -123,6 +145,14 @@ namespace nil::gate::detail
 
         void done() override
         {
+            if (std::exchange(shed, false))
+            {
+                // stays pending with its inputs changed to catch up on a later commit.
+                // the outputs keep their values in the meantime.
+                outputs_released = true;
+                std::apply([](auto&... outs) { (outs.done(), ...); }, req_outputs);
+                return;
+            }
             if (node_state != INode::ENodeState::Done)
             {
                 node_state = INode::ENodeState::Done;
@@ -139,6 +169,10 @@ namespace nil::gate::detail
                 {
                     exec();
                 }
+                else if (auto* p = this->probe(); p != nullptr)
+                {
+                    p->skipped(*this);
+                }
                 done();
             }
         }
@@ -166,6 +200,14 @@ namespace nil::gate::detail
             return input_state == INode::EInputState::Changed;
         }
 
+        std::vector<INode::Input> describe_inputs() const override
+        {
+            return std::apply(
+                [](const auto&... i) { return std::vector<INode::Input>{i.describe()...}; },
+                input_ports
+            );
+        }
+
         bool is_pending() const override
         {
             return node_state == INode::ENodeState::Pending;
@@ -241,6 +283,8 @@ namespace nil::gate::detail
 
         INode::ENodeState node_state = INode::ENodeState::Pending;
         INode::EInputState input_state = INode::EInputState::Changed;
+        bool shed = false;
+        bool outputs_released = false;
 
         Core* core;
         T instance;
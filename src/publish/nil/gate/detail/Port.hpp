@@ -4,10 +4,13 @@
 #include "../ports/Mutable.hpp"
 #include "../traits/compatibility.hpp"
 #include "../traits/port_override.hpp"
+#include "sdt.hpp"
 
 #include <memory>
 #include <optional>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace nil::gate::detail
@@ -48,6 +51,16 @@ namespace nil::gate::detail
             {
                 node->detach_in(this);
             }
+
+            for (auto* node : passive_out)
+            {
+                node->detach_in(this);
+            }
+
+            for (auto& a : adapters)
+            {
+                a.second->detach();
+            }
         }
 
         Port(Port&&) noexcept = delete;
@@ -71,12 +84,23 @@ namespace nil::gate::detail
             return data.has_value() && nil::gate::traits::port::has_value(*data);
         }
 
+        // node setting this port, nullptr when set from outside
+        const INode* producer() const noexcept
+        {
+            return parent;
+        }
+
+        std::uint64_t version() const noexcept override
+        {
+            return current_version;
+        }
+
         void set_value(T new_data) override
         {
             if (!is_equal(new_data))
             {
                 pend();
-                set(std::move(new_data));
+                assign(std::move(new_data));
                 done();
             }
         }
@@ -91,26 +115,48 @@ namespace nil::gate::detail
             }
         }
 
+        // stores a value without counting it as a change. only for ports that are not yet attached.
+        void initialize(T init_data)
+        {
+            data = std::move(init_data);
+        }
+
         bool is_equal(const T& value) const
         {
-            return has_value() && nil::gate::traits::port::is_eq(data.value(), value);
+            const auto equal = has_value() && nil::gate::traits::port::is_eq(data.value(), value);
+            NIL_GATE_SDT2(port_set, this, equal ? 0 : 1);
+            if (parent != nullptr)
+            {
+                if (auto* p = parent->probe(); p != nullptr)
+                {
+                    p->compared(*parent, equal);
+                }
+            }
+            return equal;
         }
 
         void set(T&& new_data)
         {
             if (!is_equal(new_data))
             {
-                data = std::move(new_data);
+                assign(std::move(new_data));
+            }
+        }
 
-                for (auto& a : adapters)
-                {
-                    a.second->set(*data);
-                }
+        // same as set but expects the caller to have checked is_equal already
+        void assign(T&& new_data)
+        {
+            data = std::move(new_data);
+            ++current_version;
 
-                for (auto* n : this->node_out)
-                {
-                    n->input_changed();
-                }
+            for (auto& a : adapters)
+            {
+                a.second->set(*data);
+            }
+
+            for (auto* n : this->node_out)
+            {
+                notify(n, this);
             }
         }
 
@@ -119,6 +165,7 @@ namespace nil::gate::detail
             if (has_value())
             {
                 nil::gate::traits::port::unset(data);
+                ++current_version;
 
                 for (auto& a : adapters)
                 {
@@ -126,7 +173,7 @@ namespace nil::gate::detail
                 }
                 for (auto* n : this->node_out)
                 {
-                    n->input_changed();
+                    notify(n, this);
                 }
             }
         }
@@ -140,6 +187,11 @@ namespace nil::gate::detail
                 {
                     n->pend();
                 }
+
+                for (auto& a : adapters)
+                {
+                    a.second->pend();
+                }
             }
         }
 
@@ -160,6 +212,13 @@ namespace nil::gate::detail
             node_out.push_back(node);
         }
 
+        // passive nodes are neither pended nor notified of changes.
+        // they only read the value when triggered by their other inputs.
+        void attach_passive_out(INode* node)
+        {
+            passive_out.push_back(node);
+        }
+
         void detach_in(INode* node)
         {
             if (node == parent)
@@ -171,6 +230,7 @@ namespace nil::gate::detail
         void detach_out(INode* node)
         {
             std::erase_if(node_out, [node](auto* n) { return n == node; });
+            std::erase_if(passive_out, [node](auto* n) { return n == node; });
         }
 
         bool is_ready() const
@@ -178,6 +238,11 @@ namespace nil::gate::detail
             return state != EState::Pending && has_value();
         }
 
+        bool is_pending() const
+        {
+            return state == EState::Pending;
+        }
+
         template <typename U>
             requires(!std::same_as<T, U> && !concepts::compatibility_requires_cache<U, T>)
         auto* adapt()
@@ -273,7 +338,109 @@ namespace nil::gate::detail
             );
         }
 
+        template <auto Field>
+        auto* lens()
+        {
+            using TO = std::remove_cvref_t<decltype(std::declval<const T&>().*Field)>;
+
+            // consumers of a lens are owned by the lens instead of the port.
+            // they are pended with the port but only notified of a change
+            // when the projected field itself changes.
+            struct Impl final: IAdapter
+            {
+                explicit Impl(Port<T>* init_port)
+                    : IAdapter(init_port)
+                {
+                    if (this->port->state == EState::Stale && this->port->has_value())
+                    {
+                        cache = this->port->value().*Field;
+                    }
+                }
+
+                const TO& value() const
+                {
+                    return cache.value();
+                }
+
+                void attach_out(INode* node)
+                {
+                    node_out.push_back(node);
+                }
+
+                void detach_out(INode* node)
+                {
+                    std::erase_if(node_out, [node](auto* n) { return n == node; });
+                    this->port->detach_out(node);
+                }
+
+                void set(const T& new_value) override
+                {
+                    const auto& field = new_value.*Field;
+                    if (!cache.has_value() || !nil::gate::traits::port::is_eq(*cache, field))
+                    {
+                        cache = field;
+                        for (auto* n : node_out)
+                        {
+                            notify(n, this->port);
+                        }
+                    }
+                }
+
+                void unset() override
+                {
+                    if (cache.has_value())
+                    {
+                        cache = {};
+                        for (auto* n : node_out)
+                        {
+                            notify(n, this->port);
+                        }
+                    }
+                }
+
+                void pend() override
+                {
+                    for (auto* n : node_out)
+                    {
+                        n->pend();
+                    }
+                }
+
+                void detach() override
+                {
+                    for (auto* n : node_out)
+                    {
+                        n->detach_in(this->port);
+                    }
+                }
+
+                std::optional<TO> cache;
+                std::vector<INode*> node_out;
+            };
+
+            const void* const id = &lens_id<Field>;
+            if (auto it = adapters.find(id); it != adapters.end())
+            {
+                return static_cast<Impl*>(it->second.get());
+            }
+            return static_cast<Impl*>(
+                adapters.emplace(id, std::make_unique<Impl>(this)).first->second.get()
+            );
+        }
+
     private:
+        template <auto Field>
+        static constexpr char lens_id = 0;
+
+        static void notify(INode* node, const Port* port)
+        {
+            node->input_changed();
+            if (auto* p = node->probe(); p != nullptr)
+            {
+                p->input_changed(*node, *port, port->parent);
+            }
+        }
+
         enum class EState
         {
             Stale = 0b0001,
@@ -282,8 +449,10 @@ namespace nil::gate::detail
 
         EState state;
         std::optional<T> data;
+        std::uint64_t current_version = 0;
         INode* parent;
         std::vector<INode*> node_out;
+        std::vector<INode*> passive_out;
 
         struct IAdapter
         {
@@ -304,6 +473,11 @@ namespace nil::gate::detail
                 port->attach_out(node);
             }
 
+            void attach_passive_out(INode* node)
+            {
+                port->attach_passive_out(node);
+            }
+
             void detach_out(INode* node)
             {
                 port->detach_out(node);
@@ -319,10 +493,23 @@ namespace nil::gate::detail
                 return port->score();
             }
 
+            const INode* producer() const
+            {
+                return port->producer();
+            }
+
             virtual void set(const T&) = 0;
 
             virtual void unset() = 0;
 
+            virtual void pend()
+            {
+            }
+
+            virtual void detach()
+            {
+            }
+
             Port<T>* port;
         };
 
@@ -1,11 +1,12 @@
 #pragma once
 
+#include "../Callable.hpp"
 #include "../INode.hpp"
+#include "sdt.hpp"
 #include "nil/gate/ports/Compatible.hpp"
 #include "nil/gate/ports/Mutable.hpp"
 #include "traits/node.hpp"
 
-#include <functional>
 #include <nil/xalt/checks.hpp>
 #include <nil/xalt/fn_sign.hpp>
 
@@ -32,7 +33,7 @@ namespace nil::gate
         {
             std::vector<ports::Compatible<T>> inputs;
             std::uint64_t output_size;
-            std::function<void(const Arg&)> fn;
+            Callable<void(const Arg&)> fn;
         };
 
         virtual std::vector<ports::Compatible<T>>& inputs() = 0;
@@ -47,8 +48,7 @@ namespace nil::gate::detail
     {
     public:
         UNode(Core* init_core, gate::UNode<T>::Info info)
-            : core(init_core)
-            , fn(info.fn)
+            : fn(std::move(info.fn))
             , input_ports(std::move(info.inputs))
             , output_ports(info.output_size)
         {
@@ -57,12 +57,14 @@ namespace nil::gate::detail
                 i.attach_out(this);
             }
 
+            arg.core = init_core;
+            arg.inputs.resize(input_ports.size());
+            arg.outputs.reserve(info.output_size);
             output_port_handles.reserve(info.output_size);
-            moutput_ports.reserve(info.output_size);
             for (auto& o : output_ports)
             {
                 o.attach_in(this);
-                moutput_ports.push_back(&o);
+                arg.outputs.push_back(&o);
                 output_port_handles.push_back(&o);
             }
 
@@ -100,14 +102,30 @@ namespace nil::gate::detail
 
         void exec() override
         {
-            std::vector<const T*> p_inputs;
-            p_inputs.reserve(input_ports.size());
-            for (auto& i : input_ports)
+            auto* const p = this->probe();
+            if (p != nullptr)
             {
-                p_inputs.push_back(&i.value());
+                if (p->shed(*this))
+                {
+                    shed = true;
+                    return;
+                }
+                p->exec_begin(*this);
             }
 
-            fn({.core = core, .inputs = std::move(p_inputs), .outputs = moutput_ports});
+            // refreshed in place to avoid allocating on every execution
+            for (std::size_t i = 0; i < input_ports.size(); ++i)
+            {
+                arg.inputs[i] = &input_ports[i].value();
+            }
+
+            NIL_GATE_SDT1(exec_begin, this);
+            fn(arg);
+            NIL_GATE_SDT1(exec_end, this);
+            if (p != nullptr)
+            {
+                p->exec_end(*this);
+            }
         }
 
         void pend() override
@@ -120,6 +138,11 @@ namespace nil::gate::detail
 
         void done() override
         {
+            if (std::exchange(shed, false))
+            {
+                // stays pending with its inputs changed to catch up on a later commit
+                return;
+            }
             if (node_state != INode::ENodeState::Done)
             {
                 node_state = INode::ENodeState::Done;
@@ -135,6 +158,10 @@ namespace nil::gate::detail
                 {
                     exec();
                 }
+                else if (auto* p = this->probe(); p != nullptr)
+                {
+                    p->skipped(*this);
+                }
                 done();
             }
         }
@@ -154,6 +181,17 @@ namespace nil::gate::detail
             return input_state == INode::EInputState::Changed;
         }
 
+        std::vector<INode::Input> describe_inputs() const override
+        {
+            std::vector<INode::Input> result;
+            result.reserve(input_ports.size());
+            for (const auto& i : input_ports)
+            {
+                result.push_back(i.describe());
+            }
+            return result;
+        }
+
         bool is_pending() const override
         {
             return node_state == INode::ENodeState::Pending;
@@ -192,13 +230,13 @@ namespace nil::gate::detail
     private:
         INode::ENodeState node_state = INode::ENodeState::Pending;
         INode::EInputState input_state = INode::EInputState::Changed;
+        bool shed = false;
 
-        Core* core;
-        std::function<void(const typename gate::UNode<T>::Arg&)> fn;
+        Callable<void(const typename gate::UNode<T>::Arg&)> fn;
 
         std::vector<ports::Compatible<T>> input_ports;
         std::vector<detail::Port<traits::portify_t<T>>> output_ports;
-        std::vector<ports::Mutable<T>*> moutput_ports;        // to be passed to the node
+        typename gate::UNode<T>::Arg arg;                     // to be passed to the node
         std::vector<ports::ReadOnly<T>*> output_port_handles; // to be returned by the node
         mutable std::optional<std::uint32_t> current_score;
     };
@@ -0,0 +1,19 @@
+#pragma once
+
+// Linux SDT/USDT probes (provider `nil_gate`), attachable with bpftrace/perf on live processes.
+// A probe site is a single nop while nothing is attached.
+// Compiled out when <sys/sdt.h> is unavailable or NIL_GATE_DISABLE_SDT is defined.
+//
+//  commit_begin(runner)      / commit_end(runner)
+//  exec_begin(node)          / exec_end(node)
+//  port_set(port, changed)
+//  task_enqueue(task_manager) / task_dequeue(task_manager)
+
+#if !defined(NIL_GATE_DISABLE_SDT) && __has_include(<sys/sdt.h>)
+    #include <sys/sdt.h>
+    #define NIL_GATE_SDT1(name, a1) STAP_PROBE1(nil_gate, name, a1)
+    #define NIL_GATE_SDT2(name, a1, a2) STAP_PROBE2(nil_gate, name, a1, a2)
+#else
+    #define NIL_GATE_SDT1(name, a1) ((void)0)
+    #define NIL_GATE_SDT2(name, a1, a2) ((void)0)
+#endif
@@ -3,6 +3,8 @@
 #include "../detail/Port.hpp"
 #include "../errors.hpp"
 #include "../ports/External.hpp"
+#include "../ports/Lens.hpp"
+#include "../ports/Passive.hpp"
 #include "../ports/ReadOnly.hpp"
 #include "../traits/compatibility.hpp"
 
@@ -63,11 +65,13 @@ namespace nil::gate::ports
         // NOLINTNEXTLINE(hicpp-explicit-conversions)
         Compatible(ports::ReadOnly<TO>* port)
             : context(port)
+            , source(port)
             , ptr_attach_out(&impl_attach_out<detail::Port<TO>>)
             , ptr_detach_out(&impl_detach_out<detail::Port<TO>>)
             , ptr_is_ready(&impl_is_ready<detail::Port<TO>>)
             , ptr_score(&impl_score<detail::Port<TO>>)
             , ptr_value(&impl_value<detail::Port<TO>>)
+            , ptr_producer(&impl_producer<detail::Port<TO>>)
         {
         }
 
@@ -77,6 +81,24 @@ namespace nil::gate::ports
         {
         }
 
+        template <typename T, auto Field>
+            requires(std::is_same_v<TO, typename Lens<T, Field>::type>)
+        // NOLINTNEXTLINE(hicpp-explicit-conversions)
+        Compatible(Lens<T, Field> lens)
+            : Compatible(static_cast<detail::Port<T>*>(lens.port)->template lens<Field>())
+        {
+            kind = INode::EInput::Lens;
+        }
+
+        template <typename P>
+            requires(std::is_constructible_v<Compatible, P*>)
+        // NOLINTNEXTLINE(hicpp-explicit-conversions)
+        Compatible(Passive<P> port)
+            : Compatible(port.port)
+        {
+            passive = true;
+        }
+
         ~Compatible() noexcept = default;
 
         Compatible(Compatible&&) noexcept = default;
@@ -114,7 +136,7 @@ namespace nil::gate::ports
             {
                 return;
             }
-            ptr_attach_out(context, node);
+            ptr_attach_out(context, node, passive);
         }
 
         void detach_out(INode* node)
@@ -129,16 +151,27 @@ namespace nil::gate::ports
         // called by parent node to check if a port linked to this compatible port
         // if it does, it removes itself to it. no need to detach out, this will be called
         // by node, which is triggered by the input port.
+        // source is the port itself or the port the adapter in context is reading from.
         bool detach(IPort* port)
         {
-            if (port == context)
+            if (port == source)
             {
                 context = nullptr;
+                source = nullptr;
                 return true;
             }
             return false;
         }
 
+        INode::Input describe() const
+        {
+            if (nullptr == context)
+            {
+                return {.port = nullptr, .source = nullptr, .kind = kind, .passive = passive};
+            }
+            return {.port = source, .source = ptr_producer(context), .kind = kind, .passive = passive};
+        }
+
         std::uint32_t score() const noexcept
         {
             if (nullptr == context)
@@ -160,16 +193,27 @@ namespace nil::gate::ports
     private:
         INode* parent = nullptr;
         void* context = nullptr;
-        void (*ptr_attach_out)(void*, INode*) = nullptr;
+        const IPort* source = nullptr;
+        bool passive = false;
+        INode::EInput kind = INode::EInput::Direct;
+        void (*ptr_attach_out)(void*, INode*, bool) = nullptr;
         void (*ptr_detach_out)(void*, INode*) = nullptr;
         bool (*ptr_is_ready)(const void*) = nullptr;
         std::uint32_t (*ptr_score)(const void*) = nullptr;
         const TO& (*ptr_value)(const void*) = nullptr;
+        const INode* (*ptr_producer)(const void*) = nullptr;
 
         template <typename T>
-        static void impl_attach_out(void* port, INode* node)
+        static void impl_attach_out(void* port, INode* node, bool passive)
         {
-            static_cast<T*>(port)->attach_out(node);
+            if (passive)
+            {
+                static_cast<T*>(port)->attach_passive_out(node);
+            }
+            else
+            {
+                static_cast<T*>(port)->attach_out(node);
+            }
         }
 
         template <typename T>
@@ -196,16 +240,25 @@ namespace nil::gate::ports
             return static_cast<const T*>(port)->value();
         }
 
+        template <typename T>
+        static const INode* impl_producer(const void* port)
+        {
+            return static_cast<const T*>(port)->producer();
+        }
+
         template <typename Adapter>
             requires(!std::is_base_of_v<IPort, Adapter>)
         explicit Compatible(Adapter* adapter)
             : context(adapter)
+            , source(adapter->port)
             , ptr_attach_out(&impl_attach_out<Adapter>)
             , ptr_detach_out(&impl_detach_out<Adapter>)
             , ptr_is_ready(&impl_is_ready<Adapter>)
             , ptr_score(&impl_score<Adapter>)
             , ptr_value(&impl_value<Adapter>)
+            , ptr_producer(&impl_producer<Adapter>)
         {
+            kind = INode::EInput::Convert;
         }
     };
 }
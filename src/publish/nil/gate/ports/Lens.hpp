@@ -0,0 +1,42 @@
+#pragma once
+
+#include "External.hpp"
+#include "ReadOnly.hpp"
+
+#include <type_traits>
+#include <utility>
+
+namespace nil::gate::ports
+{
+    /**
+     * @brief Projects a node input to a single field of a struct port.
+     *  Change detection and early cutoff is done on the field alone,
+     *  so the node only re-executes when that field changes.
+     *
+     *  Use `nil::gate::lens<&S::field>(port)` to create one.
+     *
+     * @tparam T     - the struct type held by the port
+     * @tparam Field - pointer to data member of T
+     */
+    template <typename T, auto Field>
+    struct Lens final
+    {
+        using type = std::remove_cvref_t<decltype(std::declval<const T&>().*Field)>;
+        ReadOnly<T>* port;
+    };
+}
+
+namespace nil::gate
+{
+    template <auto Field, typename T>
+    ports::Lens<T, Field> lens(ports::ReadOnly<T>* port)
+    {
+        return {port};
+    }
+
+    template <auto Field, typename T>
+    ports::Lens<T, Field> lens(ports::External<T>* port)
+    {
+        return {port->to_direct()};
+    }
+}
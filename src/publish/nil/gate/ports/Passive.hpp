@@ -0,0 +1,28 @@
+#pragma once
+
+namespace nil::gate::ports
+{
+    /**
+     * @brief Marks a node input as passive (sampled).
+     *  A passive input gates readiness and provides the latest value
+     *  but a change to it does not re-execute the node.
+     *
+     *  Use `nil::gate::passive(port)` to create one.
+     *
+     * @tparam P - the port type being wrapped (ReadOnly<T>, Mutable<T> or External<T>)
+     */
+    template <typename P>
+    struct Passive final
+    {
+        P* port;
+    };
+}
+
+namespace nil::gate
+{
+    template <typename P>
+    ports::Passive<P> passive(P* port)
+    {
+        return {port};
+    }
+}
@@ -2,6 +2,8 @@
 
 #include "../IPort.hpp"
 
+#include <cstdint>
+
 namespace nil::gate::ports
 {
     /**
@@ -40,5 +42,12 @@ namespace nil::gate::ports
          *   - called inside a node
          */
         [[nodiscard]] virtual bool has_value() const noexcept = 0;
+
+        /**
+         * @brief Number of times the value of the port changed (set or unset).
+         *  Compare against a previously read version to detect a change.
+         *  Same restrictions as `value`.
+         */
+        [[nodiscard]] virtual std::uint64_t version() const noexcept = 0;
     };
 }
@@ -0,0 +1,239 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__linux__)
+    #include <linux/perf_event.h>
+    #include <sys/resource.h>
+    #include <sys/syscall.h>
+    #include <time.h>
+    #include <unistd.h>
+#endif
+
+namespace nil::gate::probes
+{
+    /**
+     * @brief Performance counters of the calling thread (Linux `perf_event_open`).
+     *  Hardware counters when available. Otherwise (containers, VMs, restricted
+     *  `perf_event_paranoid`) the kernel software counters, and without perf at all
+     *  the thread CPU clock and `getrusage`. Fields that are not measured stay at 0.
+     */
+    class Counters final
+    {
+    public:
+        struct Sample
+        {
+            std::uint64_t cycles = 0;
+            std::uint64_t instructions = 0;
+            std::uint64_t cache_misses = 0;
+            std::uint64_t context_switches = 0;
+            std::chrono::nanoseconds cpu_time{0};
+
+            Sample& operator+=(const Sample& o)
+            {
+                cycles += o.cycles;
+                instructions += o.instructions;
+                cache_misses += o.cache_misses;
+                context_switches += o.context_switches;
+                cpu_time += o.cpu_time;
+                return *this;
+            }
+
+            friend Sample operator-(const Sample& l, const Sample& r)
+            {
+                return {
+                    .cycles = l.cycles - r.cycles,
+                    .instructions = l.instructions - r.instructions,
+                    .cache_misses = l.cache_misses - r.cache_misses,
+                    .context_switches = l.context_switches - r.context_switches,
+                    .cpu_time = l.cpu_time - r.cpu_time,
+                };
+            }
+        };
+
+        enum class ESource
+        {
+            None,     // not supported on this platform
+            Rusage,   // cpu_time, context_switches
+            Software, // cpu_time, context_switches
+            Hardware  // everything
+        };
+
+        /**
+         * @brief Counters of the calling thread, opened on first use.
+         */
+        static Counters& this_thread()
+        {
+            thread_local Counters c;
+            return c;
+        }
+
+        ~Counters() noexcept
+        {
+#if defined(__linux__)
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                ::close(fds[i]);
+            }
+#endif
+        }
+
+        Counters(Counters&&) = delete;
+        Counters(const Counters&) = delete;
+        Counters& operator=(Counters&&) = delete;
+        Counters& operator=(const Counters&) = delete;
+
+        ESource source() const
+        {
+            return counters_source;
+        }
+
+        Sample read() const
+        {
+            Sample s;
+#if defined(__linux__)
+            if (size != 0)
+            {
+                // PERF_FORMAT_GROUP: { nr, value[nr] }
+                std::array<std::uint64_t, 1 + max_events> values = {};
+                if (::read(fds[0], values.data(), sizeof(values)) > 0)
+                {
+                    for (std::size_t i = 0; i < size && i < values[0]; ++i)
+                    {
+                        assign(s, fields[i], values[i + 1]);
+                    }
+                }
+                return s;
+            }
+
+            timespec ts = {};
+            ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+            s.cpu_time = std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+
+            rusage ru = {};
+            ::getrusage(RUSAGE_THREAD, &ru);
+            s.context_switches = std::uint64_t(ru.ru_nvcsw + ru.ru_nivcsw);
+#endif
+            return s;
+        }
+
+    private:
+        enum class EField
+        {
+            Cycles,
+            Instructions,
+            CacheMisses,
+            ContextSwitches,
+            CpuTime
+        };
+
+        static constexpr std::size_t max_events = 5;
+
+        ESource counters_source = ESource::None;
+        std::array<int, max_events> fds = {};
+        std::array<EField, max_events> fields = {};
+        std::size_t size = 0;
+
+        static void assign(Sample& s, EField field, std::uint64_t value)
+        {
+            switch (field)
+            {
+                case EField::Cycles:
+                    s.cycles = value;
+                    break;
+                case EField::Instructions:
+                    s.instructions = value;
+                    break;
+                case EField::CacheMisses:
+                    s.cache_misses = value;
+                    break;
+                case EField::ContextSwitches:
+                    s.context_switches = value;
+                    break;
+                case EField::CpuTime:
+                    s.cpu_time = std::chrono::nanoseconds(value);
+                    break;
+            }
+        }
+
+#if defined(__linux__)
+        struct Event
+        {
+            std::uint32_t type;
+            std::uint64_t config;
+            EField field;
+        };
+
+        Counters()
+        {
+            // software events can join a group led by a hardware event
+            static constexpr std::array<Event, 5> hardware = {{
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, EField::Cycles},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, EField::Instructions},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, EField::CacheMisses},
+                {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES, EField::ContextSwitches},
+                {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK, EField::CpuTime},
+            }};
+            static constexpr std::array<Event, 2> software = {{
+                {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK, EField::CpuTime},
+                {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES, EField::ContextSwitches},
+            }};
+
+            if (open(hardware.data(), hardware.size()))
+            {
+                counters_source = ESource::Hardware;
+            }
+            else if (open(software.data(), software.size()))
+            {
+                counters_source = ESource::Software;
+            }
+            else
+            {
+                counters_source = ESource::Rusage;
+            }
+        }
+
+        // all or nothing
+        bool open(const Event* events, std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                perf_event_attr attr = {};
+                attr.size = sizeof(attr);
+                attr.type = events[i].type;
+                attr.config = events[i].config;
+                attr.read_format = PERF_FORMAT_GROUP;
+                attr.exclude_hv = 1;
+                // context switches happen in the kernel. user space only when not permitted.
+                attr.exclude_kernel = events[i].type == PERF_TYPE_HARDWARE ? 1 : 0;
+
+                const auto leader = size == 0 ? -1 : fds[0];
+                auto fd = int(::syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0));
+                if (fd < 0 && attr.exclude_kernel == 0)
+                {
+                    attr.exclude_kernel = 1;
+                    fd = int(::syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0));
+                }
+                if (fd < 0)
+                {
+                    for (std::size_t j = 0; j < size; ++j)
+                    {
+                        ::close(fds[j]);
+                    }
+                    size = 0;
+                    return false;
+                }
+                fds[size] = fd;
+                fields[size] = events[i].field;
+                ++size;
+            }
+            return true;
+        }
+#else
+        Counters() = default;
+#endif
+    };
+}
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace nil::gate::probes
+{
+    /**
+     * @brief Log-bucketed latency histogram (HdrHistogram layout).
+     *  Exact below 128ns, then 64 sub-buckets per power of two (within 1.6%),
+     *  over the whole nanosecond range. Buckets are allocated up to the largest recorded value.
+     *  Not synchronized.
+     */
+    class Histogram final
+    {
+    public:
+        void record(std::chrono::nanoseconds duration)
+        {
+            const auto value = static_cast<std::uint64_t>(std::max<std::int64_t>(duration.count(), 0));
+            const auto index = index_of(value);
+            if (index >= buckets.size())
+            {
+                buckets.resize(index + 1);
+            }
+            ++buckets[index];
+            ++total;
+            sum += value;
+            lowest = std::min(lowest, value);
+            highest = std::max(highest, value);
+        }
+
+        void merge(const Histogram& other)
+        {
+            if (other.buckets.size() > buckets.size())
+            {
+                buckets.resize(other.buckets.size());
+            }
+            for (std::size_t i = 0; i < other.buckets.size(); ++i)
+            {
+                buckets[i] += other.buckets[i];
+            }
+            total += other.total;
+            sum += other.sum;
+            lowest = std::min(lowest, other.lowest);
+            highest = std::max(highest, other.highest);
+        }
+
+        void reset()
+        {
+            buckets.clear();
+            total = 0;
+            sum = 0;
+            lowest = std::numeric_limits<std::uint64_t>::max();
+            highest = 0;
+        }
+
+        std::uint64_t count() const
+        {
+            return total;
+        }
+
+        std::chrono::nanoseconds min() const
+        {
+            return std::chrono::nanoseconds(total == 0 ? 0 : lowest);
+        }
+
+        std::chrono::nanoseconds max() const
+        {
+            return std::chrono::nanoseconds(highest);
+        }
+
+        std::chrono::nanoseconds mean() const
+        {
+            return std::chrono::nanoseconds(total == 0 ? 0 : sum / total);
+        }
+
+        /**
+         * @brief Smallest value that `percentile`% of the recorded values are at or below,
+         *  reported as the upper end of its bucket (e.g. 99.9 for p99.9).
+         */
+        std::chrono::nanoseconds percentile(double percentile) const
+        {
+            if (total == 0)
+            {
+                return std::chrono::nanoseconds(0);
+            }
+            const auto rank = std::clamp<std::uint64_t>(
+                std::uint64_t(std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * double(total))),
+                1,
+                total
+            );
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < buckets.size(); ++i)
+            {
+                seen += buckets[i];
+                if (seen >= rank)
+                {
+                    return std::chrono::nanoseconds(std::clamp(upper_of(i), lowest, highest));
+                }
+            }
+            return max();
+        }
+
+        /**
+         * @brief Calls `fn(lower, upper, count)` for every non-empty bucket, in increasing order.
+         */
+        template <typename Fn>
+        void for_each(Fn&& fn) const
+        {
+            for (std::size_t i = 0; i < buckets.size(); ++i)
+            {
+                if (buckets[i] != 0)
+                {
+                    fn(std::chrono::nanoseconds(lower_of(i)),
+                       std::chrono::nanoseconds(upper_of(i)),
+                       buckets[i]);
+                }
+            }
+        }
+
+    private:
+        static constexpr std::uint32_t sub_bits = 7;
+        static constexpr std::uint64_t sub_half = 1ULL << (sub_bits - 1);
+
+        std::vector<std::uint64_t> buckets;
+        std::uint64_t total = 0;
+        std::uint64_t sum = 0;
+        std::uint64_t lowest = std::numeric_limits<std::uint64_t>::max();
+        std::uint64_t highest = 0;
+
+        // [0, 2^sub_bits) is linear, then each power of two is split into sub_half buckets
+        static std::size_t index_of(std::uint64_t value)
+        {
+            if (value < (1ULL << sub_bits))
+            {
+                return value;
+            }
+            const auto shift = std::uint32_t(std::bit_width(value)) - sub_bits;
+            return shift * sub_half + (value >> shift);
+        }
+
+        static std::uint64_t lower_of(std::size_t index)
+        {
+            if (index < (1ULL << sub_bits))
+            {
+                return index;
+            }
+            const auto shift = index / sub_half - 1;
+            return (index % sub_half + sub_half) << shift;
+        }
+
+        static std::uint64_t upper_of(std::size_t index)
+        {
+            if (index < (1ULL << sub_bits))
+            {
+                return index;
+            }
+            const auto shift = index / sub_half - 1;
+            return lower_of(index) + ((1ULL << shift) - 1);
+        }
+    };
+}
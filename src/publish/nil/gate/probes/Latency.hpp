@@ -0,0 +1,109 @@
+#pragma once
+
+#include "../IProbe.hpp"
+#include "Histogram.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace nil::gate::probes
+{
+    /**
+     * @brief Commit latency histograms. Install with Core::set_probe.
+     *
+     *  - queue: from Core::commit to the runner starting to apply it
+     *    (every call is measured, including the ones merged into a single pass)
+     *  - commit: from the start of a pass until its nodes are done or a newer commit takes over
+     *  - levels: per score level, from scheduling its nodes until they are done (async runners)
+     */
+    class Latency final: public IProbe
+    {
+    public:
+        struct Snapshot
+        {
+            Histogram queue;
+            Histogram commit;
+            std::vector<Histogram> levels; // indexed by score
+        };
+
+        void commit_requested() override
+        {
+            const auto now = clock::now();
+            const std::lock_guard lock(mutex);
+            requested.push_back(now);
+        }
+
+        void commit_begin() override
+        {
+            const auto now = clock::now();
+            const std::lock_guard lock(mutex);
+            for (const auto& at : requested)
+            {
+                data.queue.record(now - at);
+            }
+            requested.clear();
+            commit_starts().push_back(now);
+        }
+
+        void commit_end() override
+        {
+            const auto now = clock::now();
+            auto& s = commit_starts();
+            const auto start = s.back();
+            s.pop_back();
+
+            const std::lock_guard lock(mutex);
+            data.commit.record(now - start);
+        }
+
+        void level_begin(std::uint32_t /* score */) override
+        {
+            const auto now = clock::now();
+            const std::lock_guard lock(mutex);
+            level_start = now;
+        }
+
+        void level_end(std::uint32_t score) override
+        {
+            const auto now = clock::now();
+            const std::lock_guard lock(mutex);
+            if (data.levels.size() <= score)
+            {
+                data.levels.resize(score + 1);
+            }
+            data.levels[score].record(now - level_start);
+        }
+
+        Snapshot snapshot() const
+        {
+            const std::lock_guard lock(mutex);
+            return data;
+        }
+
+        /**
+         * @brief Clears the histograms. Commits requested but not started yet are still measured.
+         */
+        void reset()
+        {
+            const std::lock_guard lock(mutex);
+            data = {};
+        }
+
+    private:
+        using clock = std::chrono::steady_clock;
+
+        mutable std::mutex mutex;
+        Snapshot data;
+        std::vector<clock::time_point> requested;
+        // levels are scheduled from a single thread, one at a time
+        clock::time_point level_start;
+
+        static std::vector<clock::time_point>& commit_starts()
+        {
+            thread_local std::vector<clock::time_point> s;
+            return s;
+        }
+    };
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "../IProbe.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <ranges>
+#include <vector>
+
+namespace nil::gate::probes
+{
+    /**
+     * @brief Forwards every hook to several probes, in the order they were added.
+     *  Install with Core::set_probe. Add and remove probes while no commit is running.
+     *
+     *  The `*_end` hooks are called in reverse order, so probes keeping a per thread stack
+     *  (Stats, Trace...) unwind their own entries even with several probes of one class.
+     *
+     *  `shed` skips the execution as soon as one of the probes returns true,
+     *  the probes after it are not asked.
+     */
+    class Multi final: public IProbe
+    {
+    public:
+        Multi() = default;
+
+        Multi(std::initializer_list<IProbe*> init_probes)
+            : probes(init_probes)
+        {
+        }
+
+        void add(IProbe* probe)
+        {
+            probes.push_back(probe);
+        }
+
+        void remove(IProbe* probe)
+        {
+            std::erase(probes, probe);
+        }
+
+        bool empty() const noexcept
+        {
+            return probes.empty();
+        }
+
+        void exec_begin(const INode& node) override
+        {
+            for (auto* p : probes)
+            {
+                p->exec_begin(node);
+            }
+        }
+
+        void exec_end(const INode& node) override
+        {
+            for (auto* p : std::views::reverse(probes))
+            {
+                p->exec_end(node);
+            }
+        }
+
+        bool shed(const INode& node) override
+        {
+            return std::ranges::any_of(probes, [&node](IProbe* p) { return p->shed(node); });
+        }
+
+        void skipped(const INode& node) override
+        {
+            for (auto* p : probes)
+            {
+                p->skipped(node);
+            }
+        }
+
+        void compared(const INode& node, bool equal) override
+        {
+            for (auto* p : probes)
+            {
+                p->compared(node, equal);
+            }
+        }
+
+        void input_changed(const INode& node, const IPort& port, const INode* source) override
+        {
+            for (auto* p : probes)
+            {
+                p->input_changed(node, port, source);
+            }
+        }
+
+        void commit_requested() override
+        {
+            for (auto* p : probes)
+            {
+                p->commit_requested();
+            }
+        }
+
+        void commit_begin() override
+        {
+            for (auto* p : probes)
+            {
+                p->commit_begin();
+            }
+        }
+
+        void commit_end() override
+        {
+            for (auto* p : std::views::reverse(probes))
+            {
+                p->commit_end();
+            }
+        }
+
+        void queued(const INode& node) override
+        {
+            for (auto* p : probes)
+            {
+                p->queued(node);
+            }
+        }
+
+        void level_begin(std::uint32_t score) override
+        {
+            for (auto* p : probes)
+            {
+                p->level_begin(score);
+            }
+        }
+
+        void level_end(std::uint32_t score) override
+        {
+            for (auto* p : std::views::reverse(probes))
+            {
+                p->level_end(score);
+            }
+        }
+
+    private:
+        std::vector<IProbe*> probes;
+    };
+}
@@ -0,0 +1,298 @@
+#pragma once
+
+#include "../Callable.hpp"
+#include "../IProbe.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace nil::gate::probes
+{
+    /**
+     * @brief Records why each node ran and the critical path of every commit.
+     *  Install with Core::set_probe.
+     *
+     *  Each executed node remembers the inputs that changed before it ran, and the nodes that
+     *  produced them. When a commit settles, the recorder builds a Report:
+     *  - the chain of executions that took the longest (execution times summed along
+     *    the dependencies, queueing not included), starting at a port set from outside
+     *  - for every executed node, the ports set from outside that led to its execution
+     *
+     *  Ports set from outside are identified as `IPort*`, compare with
+     *  `static_cast<const IPort*>(external_port->to_direct())`.
+     */
+    class Provenance final: public IProbe
+    {
+    public:
+        struct Step
+        {
+            const INode* node = nullptr;
+            const IPort* port = nullptr; // changed input that triggered the node (nullptr if new)
+            std::chrono::nanoseconds self{0};
+            std::chrono::nanoseconds cumulative{0}; // self + cumulative of the previous step
+        };
+
+        struct Cause
+        {
+            const INode* node = nullptr;
+            std::vector<const IPort*> ports; // set from outside
+        };
+
+        struct Report
+        {
+            std::vector<Step> critical_path; // in execution order
+            std::vector<Cause> causes;       // in execution order
+        };
+
+        /**
+         * @brief Cost of the changes of a port set from outside, across reports.
+         */
+        struct Feed
+        {
+            std::uint64_t changes = 0;           // commits where its change led to executions
+            std::uint64_t executions = 0;        // executions it led to
+            std::chrono::nanoseconds time{0};    // time of these executions
+            std::chrono::nanoseconds longest{0}; // longest critical path it started
+        };
+
+        Provenance() = default;
+
+        /**
+         * @brief Called with the report of each commit, on the thread that settled it.
+         */
+        explicit Provenance(Callable<void(const Report&)> init_on_report)
+            : on_report(std::move(init_on_report))
+        {
+        }
+
+        void input_changed(const INode& node, const IPort& port, const INode* source) override
+        {
+            const std::lock_guard lock(mutex);
+            auto& t = triggers[&node];
+            if (std::none_of(
+                    t.begin(),
+                    t.end(),
+                    [&](const Trigger& i) { return i.port == &port; }
+                ))
+            {
+                t.push_back({.port = &port, .source = source});
+            }
+        }
+
+        void exec_begin(const INode& /* node */) override
+        {
+            starts().push_back(clock::now());
+        }
+
+        void exec_end(const INode& node) override
+        {
+            auto& s = starts();
+            const auto self = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                clock::now() - s.back()
+            );
+            s.pop_back();
+
+            const std::lock_guard lock(mutex);
+            auto& t = triggers[&node];
+            executed.push_back({.node = &node, .self = self, .triggers = std::move(t)});
+            t.clear();
+        }
+
+        void skipped(const INode& node) override
+        {
+            const std::lock_guard lock(mutex);
+            triggers[&node].clear();
+        }
+
+        void commit_begin() override
+        {
+            const std::lock_guard lock(mutex);
+            executed.clear();
+        }
+
+        void commit_end() override
+        {
+            Report report;
+            {
+                const std::lock_guard lock(mutex);
+                report = build();
+                last_report = report;
+            }
+            if (on_report)
+            {
+                on_report(report);
+            }
+        }
+
+        /**
+         * @brief Report of the last settled commit.
+         */
+        Report last() const
+        {
+            const std::lock_guard lock(mutex);
+            return last_report;
+        }
+
+        /**
+         * @brief Ports set from outside with the cost of their changes, most expensive first.
+         */
+        std::vector<std::pair<const IPort*, Feed>> feeds() const
+        {
+            const std::lock_guard lock(mutex);
+            std::vector<std::pair<const IPort*, Feed>> result(feed_costs.begin(), feed_costs.end());
+            std::sort(
+                result.begin(),
+                result.end(),
+                [](const auto& l, const auto& r) { return l.second.time > r.second.time; }
+            );
+            return result;
+        }
+
+        void reset()
+        {
+            const std::lock_guard lock(mutex);
+            last_report = {};
+            feed_costs.clear();
+        }
+
+    private:
+        using clock = std::chrono::steady_clock;
+
+        struct Trigger
+        {
+            const IPort* port;
+            const INode* source; // nullptr when set from outside
+        };
+
+        struct Execution
+        {
+            const INode* node;
+            std::chrono::nanoseconds self;
+            std::vector<Trigger> triggers;
+        };
+
+        mutable std::mutex mutex;
+        Callable<void(const Report&)> on_report;
+        std::unordered_map<const INode*, std::vector<Trigger>> triggers;
+        std::vector<Execution> executed;
+        Report last_report;
+        std::unordered_map<const IPort*, Feed> feed_costs;
+
+        static std::vector<clock::time_point>& starts()
+        {
+            thread_local std::vector<clock::time_point> s;
+            return s;
+        }
+
+        // expects the lock to be held
+        Report build()
+        {
+            struct Info
+            {
+                std::chrono::nanoseconds cumulative{0};
+                std::size_t previous = 0; // index in `executed` + 1, 0 for none
+                const IPort* port = nullptr;
+                std::vector<const IPort*> feeds;
+            };
+
+            // executions are recorded after their producers
+            std::unordered_map<const INode*, std::size_t> index;
+            std::vector<Info> infos(executed.size());
+            for (std::size_t i = 0; i < executed.size(); ++i)
+            {
+                const auto& e = executed[i];
+                auto& info = infos[i];
+                for (const auto& t : e.triggers)
+                {
+                    if (t.source == nullptr)
+                    {
+                        info.feeds.push_back(t.port);
+                        if (info.port == nullptr)
+                        {
+                            info.port = t.port;
+                        }
+                        continue;
+                    }
+                    const auto it = index.find(t.source);
+                    if (it == index.end())
+                    {
+                        continue; // produced by an earlier commit
+                    }
+                    const auto& from = infos[it->second];
+                    for (const auto* f : from.feeds)
+                    {
+                        if (std::find(info.feeds.begin(), info.feeds.end(), f) == info.feeds.end())
+                        {
+                            info.feeds.push_back(f);
+                        }
+                    }
+                    if (info.previous == 0 || from.cumulative > infos[info.previous - 1].cumulative)
+                    {
+                        info.previous = it->second + 1;
+                        info.port = t.port;
+                    }
+                }
+                info.cumulative = e.self
+                    + (info.previous == 0 ? std::chrono::nanoseconds(0)
+                                          : infos[info.previous - 1].cumulative);
+                index[e.node] = i;
+            }
+
+            Report report;
+            report.causes.reserve(executed.size());
+            for (std::size_t i = 0; i < executed.size(); ++i)
+            {
+                report.causes.push_back({.node = executed[i].node, .ports = infos[i].feeds});
+            }
+
+            const auto last = std::max_element(
+                infos.begin(),
+                infos.end(),
+                [](const Info& l, const Info& r) { return l.cumulative < r.cumulative; }
+            );
+            for (auto i = last == infos.end() ? 0 : std::size_t(last - infos.begin()) + 1; i != 0;
+                 i = infos[i - 1].previous)
+            {
+                report.critical_path.push_back(
+                    {.node = executed[i - 1].node,
+                     .port = infos[i - 1].port,
+                     .self = executed[i - 1].self,
+                     .cumulative = infos[i - 1].cumulative}
+                );
+            }
+            std::reverse(report.critical_path.begin(), report.critical_path.end());
+
+            const auto longest = report.critical_path.empty()
+                ? std::chrono::nanoseconds(0)
+                : report.critical_path.back().cumulative;
+            std::unordered_map<const IPort*, bool> seen;
+            for (std::size_t i = 0; i < executed.size(); ++i)
+            {
+                for (const auto* f : infos[i].feeds)
+                {
+                    auto& feed = feed_costs[f];
+                    if (!std::exchange(seen[f], true))
+                    {
+                        ++feed.changes;
+                    }
+                    ++feed.executions;
+                    feed.time += executed[i].self;
+                }
+            }
+            if (!report.critical_path.empty())
+            {
+                for (const auto* f : infos[std::size_t(last - infos.begin())].feeds)
+                {
+                    feed_costs[f].longest = std::max(feed_costs[f].longest, longest);
+                }
+            }
+            executed.clear();
+            return report;
+        }
+    };
+}
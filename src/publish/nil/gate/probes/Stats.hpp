@@ -0,0 +1,137 @@
+#pragma once
+
+#include "../IProbe.hpp"
+#include "Counters.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace nil::gate::probes
+{
+    /**
+     * @brief Per-node execution statistics. Install with Core::set_probe.
+     *  Entries are keyed by node and kept until reset, including for removed nodes.
+     *  With ECounters::On, also aggregates the performance counters of the executing thread
+     *  around each execution (see Counters, a few syscalls per execution).
+     */
+    class Stats final: public IProbe
+    {
+    public:
+        struct Node
+        {
+            std::uint64_t exec_count = 0;
+            std::uint64_t skip_count = 0; // ready but no input changed (early cutoff)
+            std::uint64_t eq_count = 0;   // output comparisons
+            std::uint64_t change_count = 0;
+            std::chrono::nanoseconds total_time{0};
+            std::chrono::nanoseconds max_time{0};
+            Counters::Sample counters; // cumulative, ECounters::On only
+        };
+
+        enum class ECounters
+        {
+            Off,
+            On
+        };
+
+        Stats() = default;
+
+        explicit Stats(ECounters init_counters)
+            : with_counters(init_counters == ECounters::On)
+        {
+        }
+
+        void exec_begin(const INode& /* node */) override
+        {
+            auto& s = starts();
+            s.push_back({.counters = {}, .time = {}});
+            if (with_counters)
+            {
+                s.back().counters = Counters::this_thread().read();
+            }
+            s.back().time = clock::now();
+        }
+
+        void exec_end(const INode& node) override
+        {
+            const auto now = clock::now();
+            auto& s = starts();
+            const auto elapsed
+                = std::chrono::duration_cast<std::chrono::nanoseconds>(now - s.back().time);
+            const auto counters = with_counters
+                ? Counters::this_thread().read() - s.back().counters
+                : Counters::Sample();
+            s.pop_back();
+
+            const std::lock_guard lock(mutex);
+            auto& n = nodes[&node];
+            ++n.exec_count;
+            n.total_time += elapsed;
+            n.max_time = std::max(n.max_time, elapsed);
+            n.counters += counters;
+        }
+
+        void skipped(const INode& node) override
+        {
+            const std::lock_guard lock(mutex);
+            ++nodes[&node].skip_count;
+        }
+
+        void compared(const INode& node, bool equal) override
+        {
+            const std::lock_guard lock(mutex);
+            auto& n = nodes[&node];
+            ++n.eq_count;
+            if (!equal)
+            {
+                ++n.change_count;
+            }
+        }
+
+        Node get(const INode* node) const
+        {
+            const std::lock_guard lock(mutex);
+            if (auto it = nodes.find(node); it != nodes.end())
+            {
+                return it->second;
+            }
+            return {};
+        }
+
+        std::vector<std::pair<const INode*, Node>> snapshot() const
+        {
+            const std::lock_guard lock(mutex);
+            return {nodes.begin(), nodes.end()};
+        }
+
+        void reset()
+        {
+            const std::lock_guard lock(mutex);
+            nodes.clear();
+        }
+
+    private:
+        using clock = std::chrono::steady_clock;
+
+        struct Start
+        {
+            Counters::Sample counters;
+            clock::time_point time;
+        };
+
+        bool with_counters = false;
+        mutable std::mutex mutex;
+        std::unordered_map<const INode*, Node> nodes;
+
+        static std::vector<Start>& starts()
+        {
+            thread_local std::vector<Start> s;
+            return s;
+        }
+    };
+}
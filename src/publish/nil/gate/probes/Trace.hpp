@@ -0,0 +1,296 @@
+#pragma once
+
+#include "../IProbe.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace nil::gate::probes
+{
+    /**
+     * @brief Records commits and node executions as Chrome trace events.
+     *  Install with Core::set_probe, open the output of `write` in Perfetto or chrome://tracing.
+     *
+     *  - one slice per node execution, on the thread that ran it
+     *  - one slice per commit, on the thread that applied it
+     *  - async runners: a flow arrow from the scheduling thread to the executing thread,
+     *    with the time spent in the queue as the `wait_us` argument of the slice
+     *  - early cutoffs as instant events
+     */
+    class Trace final: public IProbe
+    {
+    public:
+        Trace()
+            : origin(clock::now())
+        {
+        }
+
+        /**
+         * @brief Name shown for the node instead of its address.
+         */
+        void set_name(const INode* node, std::string name)
+        {
+            const std::lock_guard lock(mutex);
+            names[node] = std::move(name);
+        }
+
+        void exec_begin(const INode& node) override
+        {
+            const auto now = clock::now();
+            const std::lock_guard lock(mutex);
+            frames().push_back({.start = now, .hop = take_hop(node)});
+        }
+
+        void exec_end(const INode& node) override
+        {
+            const auto now = clock::now();
+            auto& f = frames();
+            const auto frame = f.back();
+            f.pop_back();
+
+            const std::lock_guard lock(mutex);
+            add(EType::Exec, &node, frame.start, now, frame.hop);
+        }
+
+        void skipped(const INode& node) override
+        {
+            const auto now = clock::now();
+            const std::lock_guard lock(mutex);
+            add(EType::Skip, &node, now, now, take_hop(node));
+        }
+
+        void commit_begin() override
+        {
+            frames().push_back({.start = clock::now(), .hop = {}});
+        }
+
+        void commit_end() override
+        {
+            const auto now = clock::now();
+            auto& f = frames();
+            const auto frame = f.back();
+            f.pop_back();
+
+            const std::lock_guard lock(mutex);
+            add(EType::Commit, nullptr, frame.start, now, {});
+        }
+
+        void queued(const INode& node) override
+        {
+            const auto now = clock::now();
+            const std::lock_guard lock(mutex);
+            queued_at[&node] = Hop{.at = now, .tid = tid(), .id = ++flow_count};
+        }
+
+        /**
+         * @brief Writes the recorded events as Chrome trace JSON.
+         */
+        void write(std::ostream& os) const
+        {
+            const std::lock_guard lock(mutex);
+            os << R"({"displayTimeUnit":"ns","traceEvents":[)";
+            auto first = true;
+            const auto separator = [&]()
+            {
+                if (!std::exchange(first, false))
+                {
+                    os << ',';
+                }
+                os << '\n';
+            };
+
+            for (const auto& [id, t] : tids)
+            {
+                separator();
+                os << R"({"ph":"M","name":"thread_name","pid":1,"tid":)" << t
+                   << R"(,"args":{"name":"thread )" << t << R"("}})";
+            }
+
+            for (const auto& e : events)
+            {
+                separator();
+                switch (e.type)
+                {
+                    case EType::Commit:
+                        os << R"({"ph":"X","cat":"commit","name":"commit","pid":1,"tid":)" << e.tid
+                           << R"(,"ts":)" << us(e.ts) << R"(,"dur":)" << us(e.dur) << '}';
+                        break;
+                    case EType::Exec:
+                        os << R"({"ph":"X","cat":"node","name":")";
+                        write_name(os, e.node);
+                        os << R"(","pid":1,"tid":)" << e.tid << R"(,"ts":)" << us(e.ts)
+                           << R"(,"dur":)" << us(e.dur);
+                        if (e.flow != 0)
+                        {
+                            os << R"(,"args":{"wait_us":)" << us(e.wait) << '}';
+                        }
+                        os << '}';
+                        break;
+                    case EType::Skip:
+                        os << R"({"ph":"i","s":"t","cat":"skip","name":")";
+                        write_name(os, e.node);
+                        os << R"(","pid":1,"tid":)" << e.tid << R"(,"ts":)" << us(e.ts) << '}';
+                        break;
+                }
+
+                if (e.flow != 0)
+                {
+                    // hop from the scheduling thread to the executing thread
+                    separator();
+                    os << R"({"ph":"s","cat":"hop","name":"queue","pid":1,"tid":)" << e.flow_tid
+                       << R"(,"ts":)" << us(e.ts - e.wait) << R"(,"id":)" << e.flow << '}';
+                    separator();
+                    os << R"({"ph":"f","bp":"e","cat":"hop","name":"queue","pid":1,"tid":)"
+                       << e.tid << R"(,"ts":)" << us(e.ts) << R"(,"id":)" << e.flow << '}';
+                }
+            }
+            os << "\n]}\n";
+        }
+
+        void clear()
+        {
+            const std::lock_guard lock(mutex);
+            events.clear();
+            queued_at.clear();
+        }
+
+    private:
+        using clock = std::chrono::steady_clock;
+
+        enum class EType
+        {
+            Commit,
+            Exec,
+            Skip
+        };
+
+        struct Event
+        {
+            EType type;
+            const INode* node = nullptr;
+            std::uint32_t tid = 0;
+            std::chrono::nanoseconds ts{0};
+            std::chrono::nanoseconds dur{0};
+            std::chrono::nanoseconds wait{0};
+            std::uint64_t flow = 0;
+            std::uint32_t flow_tid = 0;
+        };
+
+        // node handed over by the scheduling thread (id 0 when not queued)
+        struct Hop
+        {
+            clock::time_point at;
+            std::uint32_t tid = 0;
+            std::uint64_t id = 0;
+        };
+
+        struct Frame
+        {
+            clock::time_point start;
+            Hop hop;
+        };
+
+        clock::time_point origin;
+        mutable std::mutex mutex;
+        std::vector<Event> events;
+        std::unordered_map<const INode*, std::string> names;
+        std::unordered_map<std::thread::id, std::uint32_t> tids;
+        std::unordered_map<const INode*, Hop> queued_at;
+        std::uint64_t flow_count = 0;
+
+        static std::vector<Frame>& frames()
+        {
+            thread_local std::vector<Frame> f;
+            return f;
+        }
+
+        std::chrono::nanoseconds since_origin(clock::time_point t) const
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(t - origin);
+        }
+
+        static double us(std::chrono::nanoseconds ns)
+        {
+            return double(ns.count()) / 1000.0;
+        }
+
+        // expects the lock to be held
+        std::uint32_t tid()
+        {
+            return tids.try_emplace(std::this_thread::get_id(), std::uint32_t(tids.size() + 1))
+                .first->second;
+        }
+
+        // expects the lock to be held
+        Hop take_hop(const INode& node)
+        {
+            if (auto it = queued_at.find(&node); it != queued_at.end())
+            {
+                const auto hop = it->second;
+                queued_at.erase(it);
+                return hop;
+            }
+            return {};
+        }
+
+        // expects the lock to be held
+        void add(
+            EType type,
+            const INode* node,
+            clock::time_point start,
+            clock::time_point end,
+            const Hop& hop
+        )
+        {
+            events.push_back(Event{
+                .type = type,
+                .node = node,
+                .tid = tid(),
+                .ts = since_origin(start),
+                .dur = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start),
+                .wait = hop.id != 0
+                    ? std::chrono::duration_cast<std::chrono::nanoseconds>(start - hop.at)
+                    : std::chrono::nanoseconds(0),
+                .flow = hop.id,
+                .flow_tid = hop.tid,
+            });
+        }
+
+        // expects the lock to be held
+        void write_name(std::ostream& os, const INode* node) const
+        {
+            if (auto it = names.find(node); it != names.end())
+            {
+                for (const auto c : std::string_view(it->second))
+                {
+                    if (c == '"' || c == '\\')
+                    {
+                        os << '\\' << c;
+                    }
+                    else if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        os << ' ';
+                    }
+                    else
+                    {
+                        os << c;
+                    }
+                }
+                return;
+            }
+            std::array<char, 32> buffer = {};
+            std::snprintf(buffer.data(), buffer.size(), "node@%p", static_cast<const void*>(node));
+            os << buffer.data();
+        }
+    };
+}
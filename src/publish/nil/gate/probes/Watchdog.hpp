@@ -0,0 +1,245 @@
+#pragma once
+
+#include "../Callable.hpp"
+#include "../IProbe.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace nil::gate::probes
+{
+    /**
+     * @brief Detects node executions exceeding their time budget. Install with Core::set_probe.
+     *
+     *  A monitor thread reports executions still running past their budget (once per execution),
+     *  so a stalled node is visible before it returns. Executions that finish over budget
+     *  without having been reported yet are reported when they end.
+     *
+     *  With shedding enabled, a commit following one with an overrun skips the execution
+     *  of the nodes marked as sheddable. Their outputs keep their previous values and they
+     *  catch up with the missed changes on the first commit once the overload is gone.
+     */
+    class Watchdog final: public IProbe
+    {
+    public:
+        struct Overrun
+        {
+            const INode* node = nullptr;
+            std::chrono::nanoseconds elapsed{0};
+            std::chrono::nanoseconds budget{0};
+            bool running = false; // reported by the monitor thread while still executing
+        };
+
+        /**
+         * @brief `on_overrun` is called from the monitor thread (running executions)
+         *  or from the thread that executed the node (finished executions), possibly concurrently.
+         *  `period` is how often running executions are checked.
+         */
+        explicit Watchdog(
+            Callable<void(const Overrun&)> init_on_overrun,
+            std::chrono::nanoseconds period = std::chrono::milliseconds(1)
+        )
+            : on_overrun(std::move(init_on_overrun))
+            , monitor([this, period]() { watch(period); })
+        {
+        }
+
+        ~Watchdog() noexcept override
+        {
+            {
+                const std::lock_guard lock(mutex);
+                stopping = true;
+            }
+            wake.notify_one();
+            monitor.join();
+        }
+
+        Watchdog(Watchdog&&) = delete;
+        Watchdog(const Watchdog&) = delete;
+        Watchdog& operator=(Watchdog&&) = delete;
+        Watchdog& operator=(const Watchdog&) = delete;
+
+        /**
+         * @brief Budget of each execution of `node`. A zero budget removes it.
+         */
+        void set_budget(const INode* node, std::chrono::nanoseconds budget)
+        {
+            const std::lock_guard lock(mutex);
+            if (budget.count() == 0)
+            {
+                budgets.erase(node);
+            }
+            else
+            {
+                budgets[node] = budget;
+            }
+        }
+
+        /**
+         * @brief Marks `node` as low priority, skipped under overload when shedding is enabled.
+         */
+        void set_sheddable(const INode* node, bool sheddable)
+        {
+            const std::lock_guard lock(mutex);
+            if (sheddable)
+            {
+                sheddables.insert(node);
+            }
+            else
+            {
+                sheddables.erase(node);
+            }
+        }
+
+        void enable_shedding(bool enabled)
+        {
+            const std::lock_guard lock(mutex);
+            shedding = enabled;
+        }
+
+        /**
+         * @brief Number of executions skipped by shedding.
+         */
+        std::uint64_t shed_count() const
+        {
+            const std::lock_guard lock(mutex);
+            return skipped_count;
+        }
+
+        bool shed(const INode& node) override
+        {
+            const std::lock_guard lock(mutex);
+            if (overloaded && sheddables.contains(&node))
+            {
+                ++skipped_count;
+                return true;
+            }
+            return false;
+        }
+
+        void exec_begin(const INode& node) override
+        {
+            const auto now = clock::now();
+            const std::lock_guard lock(mutex);
+            if (auto it = budgets.find(&node); it != budgets.end())
+            {
+                running.push_back({
+                    .node = &node,
+                    .thread = std::this_thread::get_id(),
+                    .start = now,
+                    .budget = it->second,
+                    .reported = false,
+                });
+            }
+        }
+
+        void exec_end(const INode& node) override
+        {
+            const auto now = clock::now();
+            Overrun overrun;
+            {
+                const std::lock_guard lock(mutex);
+                // latest first, a node may commit (and execute other nodes) inline
+                const auto it = std::find_if(
+                    running.rbegin(),
+                    running.rend(),
+                    [&](const Execution& e)
+                    { return e.node == &node && e.thread == std::this_thread::get_id(); }
+                );
+                if (it == running.rend())
+                {
+                    return;
+                }
+                const auto e = *it;
+                running.erase(std::next(it).base());
+
+                const auto elapsed
+                    = std::chrono::duration_cast<std::chrono::nanoseconds>(now - e.start);
+                if (elapsed <= e.budget)
+                {
+                    return;
+                }
+                overran = true;
+                if (e.reported)
+                {
+                    return;
+                }
+                overrun = {.node = e.node, .elapsed = elapsed, .budget = e.budget, .running = false};
+            }
+            on_overrun(overrun);
+        }
+
+        void commit_begin() override
+        {
+            const std::lock_guard lock(mutex);
+            overloaded = shedding && std::exchange(overran, false);
+        }
+
+    private:
+        using clock = std::chrono::steady_clock;
+
+        struct Execution
+        {
+            const INode* node;
+            std::thread::id thread;
+            clock::time_point start;
+            std::chrono::nanoseconds budget;
+            bool reported;
+        };
+
+        mutable std::mutex mutex;
+        std::condition_variable wake;
+        bool stopping = false;
+        Callable<void(const Overrun&)> on_overrun;
+        std::unordered_map<const INode*, std::chrono::nanoseconds> budgets;
+        std::unordered_set<const INode*> sheddables;
+        std::vector<Execution> running;
+        bool shedding = false;
+        bool overran = false;    // since the last commit started
+        bool overloaded = false; // shedding in the current commit
+        std::uint64_t skipped_count = 0;
+        std::thread monitor; // last, started once everything else is initialized
+
+        void watch(std::chrono::nanoseconds period)
+        {
+            std::vector<Overrun> overruns;
+            std::unique_lock lock(mutex);
+            while (!wake.wait_for(lock, period, [this]() { return stopping; }))
+            {
+                const auto now = clock::now();
+                for (auto& e : running)
+                {
+                    const auto elapsed
+                        = std::chrono::duration_cast<std::chrono::nanoseconds>(now - e.start);
+                    if (!e.reported && elapsed > e.budget)
+                    {
+                        e.reported = true;
+                        overran = true;
+                        overruns.push_back(
+                            {.node = e.node, .elapsed = elapsed, .budget = e.budget, .running = true}
+                        );
+                    }
+                }
+
+                if (!overruns.empty())
+                {
+                    lock.unlock();
+                    for (const auto& o : overruns)
+                    {
+                        on_overrun(o);
+                    }
+                    overruns.clear();
+                    lock.lock();
+                }
+            }
+        }
+    };
+}
@@ -1,41 +1,56 @@
 #pragma once
 
+#include "../detail/sdt.hpp"
 #include "AsyncT.hpp"
 
 #include <algorithm>
 #include <condition_variable>
-#include <functional>
 #include <mutex>
-#include <queue>
 #include <thread>
 #include <utility>
+#include <vector>
 
 namespace nil::gate::runners
 {
     class TaskManager
     {
+    public:
+        // sized to hold the runner closures (including a forwarded `apply_changes`) inline
+        using Task = Callable<void(), 8 * sizeof(void*)>;
+
     private:
+        /**
+         * @brief Ring buffer of tasks. Only allocates when it grows past its largest size so far.
+         */
         class Queue
         {
         public:
-            void push(std::function<void()> task)
+            void push(Task task)
             {
                 std::unique_lock lock(mutex_);
-                tasks.push(std::move(task));
+                if (count == tasks.size())
+                {
+                    grow();
+                }
+                tasks[(head + count) % tasks.size()] = std::move(task);
+                ++count;
+                NIL_GATE_SDT1(task_enqueue, this);
                 cv.notify_one();
             }
 
-            std::function<void()> pop()
+            Task pop()
             {
                 std::unique_lock lock(mutex_);
-                cv.wait(lock, [&] { return stop_flag || !tasks.empty(); });
-                if (stop_flag || tasks.empty())
+                cv.wait(lock, [&] { return stop_flag || count != 0; });
+                if (stop_flag || count == 0)
                 {
                     return {};
                 }
 
-                auto task = std::move(tasks.front());
-                tasks.pop();
+                auto task = std::move(tasks[head]);
+                head = (head + 1) % tasks.size();
+                --count;
+                NIL_GATE_SDT1(task_dequeue, this);
                 return task;
             }
 
@@ -47,10 +62,23 @@ namespace nil::gate::runners
             }
 
         private:
-            std::queue<std::function<void()>> tasks;
+            std::vector<Task> tasks;
+            std::size_t head = 0;
+            std::size_t count = 0;
             std::mutex mutex_;
             std::condition_variable cv;
             bool stop_flag = false;
+
+            void grow()
+            {
+                std::vector<Task> new_tasks(std::max<std::size_t>(16, tasks.size() * 2));
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    new_tasks[i] = std::move(tasks[(head + i) % tasks.size()]);
+                }
+                tasks = std::move(new_tasks);
+                head = 0;
+            }
         };
 
     public:
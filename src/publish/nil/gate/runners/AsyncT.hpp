@@ -1,10 +1,14 @@
 #pragma once
 
 #include "../IRunner.hpp"
+#include "../detail/sdt.hpp"
 
 #include <algorithm>
-#include <unordered_set>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace nil::gate::runners
 {
@@ -12,6 +16,10 @@ namespace nil::gate::runners
     class AsyncT: public IRunner
     {
     public:
+        using Task = Callable<void(), 8 * sizeof(void*)>;
+        // receives the tasks of the nodes with a given affinity. must eventually call each task once.
+        using Executor = Callable<void(Task)>;
+
         explicit AsyncT(std::size_t count)
             : main_tasks(1)
             , exec_tasks(count)
@@ -25,6 +33,13 @@ namespace nil::gate::runners
 
             main_tasks.join();
             exec_tasks.join();
+
+            // only touched from the main task, which is done by now
+            for (auto& [tag, tasks] : affine_tasks)
+            {
+                tasks->stop();
+                tasks->join();
+            }
         }
 
         AsyncT(AsyncT&&) = delete;
@@ -32,7 +47,30 @@ namespace nil::gate::runners
         AsyncT& operator=(AsyncT&&) = delete;
         AsyncT& operator=(const AsyncT&) = delete;
 
-        void run(std::function<std::span<INode* const>()> apply_changes) override
+        /**
+         * @brief Routes the nodes with the affinity `tag` to `executor` (e.g. a queue drained
+         *  by the thread that owns an interpreter). Tags without an executor get a dedicated thread.
+         *  An empty executor restores that default. Tasks handed to an executor must be run
+         *  before the runner is destroyed.
+         */
+        void set_executor(std::uint32_t tag, Executor executor)
+        {
+            main_tasks.push(
+                [this, tag, executor = std::move(executor)]() mutable
+                {
+                    if (executor)
+                    {
+                        executors[tag] = std::move(executor);
+                    }
+                    else
+                    {
+                        executors.erase(tag);
+                    }
+                }
+            );
+        }
+
+        void run(Callable<std::span<INode* const>()> apply_changes) override
         {
             main_tasks.push(
                 [this, apply_changes = std::move(apply_changes)]() mutable
@@ -42,22 +80,39 @@ namespace nil::gate::runners
                         all_diffs.emplace_back(std::move(apply_changes));
                     }
 
-                    if (!running_list.empty())
+                    if (running_count != 0)
                     {
                         return;
                     }
 
+                    // an interrupted pass ends here, its remaining levels are merged into this one
+                    end_commit();
+                    committing = true;
+                    if (auto* p = probe(); p != nullptr)
+                    {
+                        p->commit_begin();
+                    }
+                    NIL_GATE_SDT1(commit_begin, this);
+
+                    // swap keeps the capacity of both buffers across commits
+                    std::swap(all_diffs, applying_diffs);
                     std::span<INode* const> nodes;
-                    for (const auto& dd : std::exchange(all_diffs, {}))
+                    for (auto& dd : applying_diffs)
                     {
                         if (dd)
                         {
                             nodes = dd();
                         }
                     }
+                    applying_diffs.clear();
+
+                    // levels left over from an interrupted pass
+                    for (auto i = current_score; i < score_count; ++i)
+                    {
+                        waiting_list[i].clear();
+                    }
 
                     auto max_score = 0U;
-                    waiting_list.clear();
                     for (const auto& node : nodes)
                     {
                         if (node == nullptr)
@@ -66,7 +121,12 @@ namespace nil::gate::runners
                         }
                         max_score = std::max(max_score, node->score());
                     }
-                    waiting_list.resize(max_score + 1);
+                    // only grows. inner lists are cleared when consumed by run_score.
+                    score_count = max_score + 1;
+                    if (waiting_list.size() < score_count)
+                    {
+                        waiting_list.resize(score_count);
+                    }
 
                     current_score = 0U;
                     for (const auto& node : nodes)
@@ -84,14 +144,20 @@ namespace nil::gate::runners
         }
 
     private:
-        std::unordered_set<INode*> running_list;
+        std::size_t running_count = 0U;
         std::vector<std::vector<INode*>> waiting_list;
 
-        std::vector<std::function<std::span<INode* const>()>> all_diffs;
+        std::vector<Callable<std::span<INode* const>()>> all_diffs;
+        std::vector<Callable<std::span<INode* const>()>> applying_diffs;
 
         std::uint32_t current_score = 0U;
+        std::uint32_t score_count = 0U;
+        bool committing = false;
+        bool in_level = false;
         TaskManager main_tasks;
         TaskManager exec_tasks;
+        std::unordered_map<std::uint32_t, Executor> executors;
+        std::unordered_map<std::uint32_t, std::unique_ptr<TaskManager>> affine_tasks;
 
         void run_node(INode* node)
         {
@@ -100,52 +166,114 @@ namespace nil::gate::runners
                 return;
             }
 
-            running_list.emplace(node);
-            exec_tasks.push(
-                [this, node]()
+            ++running_count;
+            if (auto* p = probe(); p != nullptr)
+            {
+                p->queued(*node);
+            }
+            auto task = [this, node]()
+            {
+                if (node->is_input_changed())
                 {
-                    if (node->is_input_changed())
-                    {
-                        node->exec();
-                    }
-                    main_tasks.push([this, node]() { mark_done(node); });
+                    node->exec();
                 }
-            );
+                else if (auto* p = node->probe(); p != nullptr)
+                {
+                    p->skipped(*node);
+                }
+                main_tasks.push([this, node]() { mark_done(node); });
+            };
+
+            if (const auto tag = node->affinity(); tag != 0)
+            {
+                run_affine(tag, std::move(task));
+            }
+            else
+            {
+                exec_tasks.push(std::move(task));
+            }
+        }
+
+        void run_affine(std::uint32_t tag, Task task)
+        {
+            if (auto it = executors.find(tag); it != executors.end())
+            {
+                it->second(std::move(task));
+                return;
+            }
+
+            auto& tasks = affine_tasks[tag];
+            if (!tasks)
+            {
+                tasks = std::make_unique<TaskManager>(1);
+            }
+            tasks->push(std::move(task));
         }
 
         void mark_done(INode* node)
         {
             node->done();
-            running_list.erase(node);
+            --running_count;
 
             if (!all_diffs.empty())
             {
-                if (running_list.empty())
+                if (running_count == 0)
                 {
                     run({});
                 }
             }
             else
             {
-                if (running_list.empty())
+                if (running_count == 0)
                 {
                     run_score();
                 }
             }
         }
 
+        void end_level()
+        {
+            if (std::exchange(in_level, false))
+            {
+                if (auto* p = probe(); p != nullptr)
+                {
+                    p->level_end(current_score - 1);
+                }
+            }
+        }
+
+        void end_commit()
+        {
+            end_level();
+            if (std::exchange(committing, false))
+            {
+                NIL_GATE_SDT1(commit_end, this);
+                if (auto* p = probe(); p != nullptr)
+                {
+                    p->commit_end();
+                }
+            }
+        }
+
         void run_score()
         {
-            if (current_score == waiting_list.size())
+            if (current_score == score_count)
             {
+                end_commit();
                 return;
             }
 
-            if (!running_list.empty())
+            if (running_count != 0)
             {
                 return;
             }
 
+            end_level();
+            if (auto* p = probe(); p != nullptr && !waiting_list[current_score].empty())
+            {
+                in_level = true;
+                p->level_begin(current_score);
+            }
             for (const auto& n : waiting_list[current_score])
             {
                 run_node(n);
@@ -153,7 +281,7 @@ namespace nil::gate::runners
             waiting_list[current_score].clear();
             ++current_score;
 
-            if (running_list.empty())
+            if (running_count == 0)
             {
                 run_score();
             }
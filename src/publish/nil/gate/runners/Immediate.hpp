@@ -1,19 +1,27 @@
 #pragma once
 
 #include "../IRunner.hpp"
+#include "../detail/sdt.hpp"
 
 namespace nil::gate::runners
 {
     class Immediate final: public IRunner
     {
     public:
-        void run(std::function<std::span<INode* const>()> apply_changes) override
+        void run(Callable<std::span<INode* const>()> apply_changes) override
         {
             if (!apply_changes)
             {
                 return;
             }
 
+            auto* p = probe();
+            if (p != nullptr)
+            {
+                p->commit_begin();
+            }
+            NIL_GATE_SDT1(commit_begin, this);
+
             for (const auto& node : apply_changes())
             {
                 if (nullptr != node)
@@ -21,6 +29,12 @@ namespace nil::gate::runners
                     node->run();
                 }
             }
+
+            NIL_GATE_SDT1(commit_end, this);
+            if (p != nullptr)
+            {
+                p->commit_end();
+            }
         }
     };
 }
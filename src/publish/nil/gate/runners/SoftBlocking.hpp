@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../IRunner.hpp"
+#include "../detail/sdt.hpp"
 
 #include <mutex>
 #include <utility>
@@ -20,7 +21,7 @@ namespace nil::gate::runners
         SoftBlocking& operator=(SoftBlocking&&) = delete;
         SoftBlocking& operator=(const SoftBlocking&) = delete;
 
-        void run(std::function<std::span<INode* const>()> apply_changes) override
+        void run(Callable<std::span<INode* const>()> apply_changes) override
         {
             bool should_use_this_thread = true;
             {
@@ -37,26 +38,34 @@ namespace nil::gate::runners
 
             while (true)
             {
-                auto tasks_to_execute = [this]() -> decltype(tasks)
                 {
                     auto lock = std::unique_lock(mutex);
                     is_running = !tasks.empty();
-                    return std::exchange(tasks, {});
-                }();
+                    // swap keeps the capacity of both buffers across commits
+                    std::swap(tasks, executing);
+                }
 
-                if (tasks_to_execute.empty())
+                if (executing.empty())
                 {
                     break;
                 }
 
+                auto* p = probe();
+                if (p != nullptr)
+                {
+                    p->commit_begin();
+                }
+                NIL_GATE_SDT1(commit_begin, this);
+
                 std::span<INode* const> nodes;
-                for (const auto& task : tasks_to_execute)
+                for (auto& task : executing)
                 {
                     if (task)
                     {
                         nodes = task();
                     }
                 }
+                executing.clear();
 
                 for (const auto& node : nodes)
                 {
@@ -65,6 +74,12 @@ namespace nil::gate::runners
                         node->run();
                     }
                 }
+
+                NIL_GATE_SDT1(commit_end, this);
+                if (p != nullptr)
+                {
+                    p->commit_end();
+                }
             }
         }
 
@@ -72,6 +87,8 @@ namespace nil::gate::runners
         bool is_running = false;
         std::mutex mutex;
 
-        std::vector<std::function<std::span<INode* const>()>> tasks;
+        std::vector<Callable<std::span<INode* const>()>> tasks;
+        // only accessed by the thread that owns the run loop
+        std::vector<Callable<std::span<INode* const>()>> executing;
     };
 }
@@ -54,7 +54,15 @@ namespace nil::gate::runners::boost_asio
         template <typename T>
         void push(T cb)
         {
-            boost::asio::post(context, std::move(cb));
+            NIL_GATE_SDT1(task_enqueue, this);
+            boost::asio::post(
+                context,
+                [this, cb = std::move(cb)]() mutable
+                {
+                    NIL_GATE_SDT1(task_dequeue, this);
+                    cb();
+                }
+            );
         }
 
     private:
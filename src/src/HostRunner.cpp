@@ -0,0 +1,133 @@
+#include "HostRunner.hpp"
+
+#include <nil/gate/detail/sdt.hpp>
+
+#include <utility>
+
+namespace nil::gate::c
+{
+    void HostRunner::run(Callable<std::span<INode* const>()> apply_changes)
+    {
+        if (apply_changes)
+        {
+            const auto lock = std::unique_lock(mutex);
+            diffs.emplace_back(std::move(apply_changes));
+        }
+    }
+
+    std::span<const nil_gate_node_args* const> HostRunner::next()
+    {
+        done();
+
+        while (true)
+        {
+            if (cursor == nodes.size())
+            {
+                auto* p = probe();
+                if (std::exchange(committing, false))
+                {
+                    NIL_GATE_SDT1(commit_end, this);
+                    if (p != nullptr)
+                    {
+                        p->commit_end();
+                    }
+                }
+
+                {
+                    const auto lock = std::unique_lock(mutex);
+                    // swap keeps the capacity of both buffers across commits
+                    std::swap(diffs, applying_diffs);
+                }
+
+                if (applying_diffs.empty())
+                {
+                    return {};
+                }
+
+                committing = true;
+                if (p != nullptr)
+                {
+                    p->commit_begin();
+                }
+                NIL_GATE_SDT1(commit_begin, this);
+
+                for (auto& diff : applying_diffs)
+                {
+                    nodes = diff();
+                }
+                applying_diffs.clear();
+                cursor = 0;
+            }
+
+            while (cursor < nodes.size())
+            {
+                auto* node = nodes[cursor];
+                // nodes of the same score do not depend on each other
+                if (!batch_nodes.empty() && node != nullptr && node->score() != batch_score)
+                {
+                    break;
+                }
+                ++cursor;
+
+                if (node == nullptr || !node->is_pending() || !node->is_ready())
+                {
+                    continue;
+                }
+
+                if (node->is_input_changed())
+                {
+                    auto* const p = node->probe();
+                    if (p != nullptr)
+                    {
+                        holding.target = p;
+                        holding.deferred = false;
+                        node->set_probe(&holding);
+                    }
+                    const auto deferred = batch_args.size();
+                    node->exec();
+                    if (p != nullptr)
+                    {
+                        node->set_probe(p);
+                    }
+                    if (deferred != batch_args.size())
+                    {
+                        batch_score = node->score();
+                        batch_nodes.push_back(node);
+                        continue;
+                    }
+                }
+                else if (auto* p = node->probe(); p != nullptr)
+                {
+                    p->skipped(*node);
+                }
+                node->done();
+            }
+
+            if (!batch_args.empty())
+            {
+                return batch_args;
+            }
+        }
+    }
+
+    void HostRunner::done()
+    {
+        // latest first, probes may pair exec_begin/exec_end with a stack
+        for (auto it = batch_nodes.rbegin(); it != batch_nodes.rend(); ++it)
+        {
+            if (auto* p = (*it)->probe(); p != nullptr)
+            {
+                p->exec_end(**it);
+            }
+            (*it)->done();
+        }
+        batch_nodes.clear();
+        batch_args.clear();
+    }
+
+    void HostRunner::defer(const nil_gate_node_args* args)
+    {
+        holding.deferred = true;
+        batch_args.push_back(args);
+    }
+}
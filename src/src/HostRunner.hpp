@@ -0,0 +1,97 @@
+#pragma once
+
+#include <nil/gate.h>
+#include <nil/gate/IRunner.hpp>
+
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace nil::gate::c
+{
+    /**
+     * @brief Runner driven by the host through `nil_gate_core_next` / `nil_gate_core_done`.
+     *
+     *  Commits are queued and only applied when the host asks for the next batch.
+     *  Native nodes run inline. Host nodes (`exec == NULL`) are handed back to the host,
+     *  one score level at a time, so that the host can run them in its own loop.
+     *  Probes see a host node executing from the hand-over until `done`.
+     */
+    class HostRunner final: public IRunner
+    {
+    public:
+        HostRunner() = default;
+        ~HostRunner() noexcept override = default;
+
+        HostRunner(HostRunner&&) = delete;
+        HostRunner(const HostRunner&) = delete;
+        HostRunner& operator=(HostRunner&&) = delete;
+        HostRunner& operator=(const HostRunner&) = delete;
+
+        void run(Callable<std::span<INode* const>()> apply_changes) override;
+
+        /**
+         * @brief Runs the graph up to the next level with host nodes to execute.
+         *  Completes the previous batch if the host did not call `done`.
+         *  Empty when there is nothing left to run.
+         */
+        std::span<const nil_gate_node_args* const> next();
+
+        /**
+         * @brief Marks the nodes of the current batch as done.
+         */
+        void done();
+
+        /**
+         * @brief Called by a host node instead of executing.
+         */
+        void defer(const nil_gate_node_args* args);
+
+    private:
+        // stands in for the probe of a node while `next` executes it.
+        // the exec_end of a host node is held until `done`, when the host has run it.
+        struct Holding final: IProbe
+        {
+            IProbe* target = nullptr;
+            bool deferred = false;
+
+            bool shed(const INode& node) override
+            {
+                return target->shed(node);
+            }
+
+            void exec_begin(const INode& node) override
+            {
+                target->exec_begin(node);
+            }
+
+            void exec_end(const INode& node) override
+            {
+                if (!deferred)
+                {
+                    target->exec_end(node);
+                }
+            }
+
+            void compared(const INode& node, bool equal) override
+            {
+                target->compared(node, equal);
+            }
+        };
+
+        std::mutex mutex;
+        std::vector<Callable<std::span<INode* const>()>> diffs;
+        // only accessed by the host thread
+        std::vector<Callable<std::span<INode* const>()>> applying_diffs;
+
+        std::span<INode* const> nodes;
+        std::size_t cursor = 0;
+        bool committing = false;
+
+        std::uint32_t batch_score = 0;
+        std::vector<INode*> batch_nodes;
+        std::vector<const nil_gate_node_args*> batch_args;
+        Holding holding;
+    };
+}
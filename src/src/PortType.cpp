@@ -1,5 +1,114 @@
 #include "PortType.hpp"
 
+#include <nil/gate.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace
+{
+    // storage of a blob value. `blob` is first so that the value can be read as `nil_gate_blob`.
+    //  - owned: the bytes follow the storage (single allocation).
+    //  - borrowed: `release(owner)` is called when the value is destroyed.
+    struct BlobStorage
+    {
+        nil_gate_blob blob;
+        void* owner;
+        void (*release)(void*);
+    };
+
+    BlobStorage* allocate_blob(std::size_t extra)
+    {
+        auto* storage = static_cast<BlobStorage*>(std::malloc(sizeof(BlobStorage) + extra)); // NOLINT
+        if (storage == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return storage;
+    }
+}
+
+extern "C"
+{
+    int nil_gate_port_eq_i64(const void* l, const void* r)
+    {
+        if (l == nullptr || r == nullptr)
+        {
+            return l == r ? 1 : 0;
+        }
+        return *static_cast<const int64_t*>(l) == *static_cast<const int64_t*>(r) ? 1 : 0;
+    }
+
+    void nil_gate_port_destroy_i64(void* /* value */)
+    {
+    }
+
+    int nil_gate_port_eq_f64(const void* l, const void* r)
+    {
+        if (l == nullptr || r == nullptr)
+        {
+            return l == r ? 1 : 0;
+        }
+        return *static_cast<const double*>(l) == *static_cast<const double*>(r) ? 1 : 0;
+    }
+
+    void nil_gate_port_destroy_f64(void* /* value */)
+    {
+    }
+
+    int nil_gate_port_eq_bool(const void* l, const void* r)
+    {
+        if (l == nullptr || r == nullptr)
+        {
+            return l == r ? 1 : 0;
+        }
+        return (*static_cast<const int*>(l) != 0) == (*static_cast<const int*>(r) != 0) ? 1 : 0;
+    }
+
+    void nil_gate_port_destroy_bool(void* /* value */)
+    {
+    }
+
+    int nil_gate_port_eq_blob(const void* l, const void* r)
+    {
+        if (l == nullptr || r == nullptr)
+        {
+            return l == r ? 1 : 0;
+        }
+        const auto* lb = static_cast<const nil_gate_blob*>(l);
+        const auto* rb = static_cast<const nil_gate_blob*>(r);
+        if (lb->size != rb->size)
+        {
+            return 0;
+        }
+        // the same borrowed buffer set again
+        if (lb->data == rb->data)
+        {
+            return 1;
+        }
+        return 0 == std::memcmp(lb->data, rb->data, lb->size) ? 1 : 0;
+    }
+
+    void nil_gate_port_destroy_blob(void* value)
+    {
+        auto* storage = static_cast<BlobStorage*>(value);
+        if (storage != nullptr && storage->release != nullptr)
+        {
+            storage->release(storage->owner);
+        }
+        std::free(value); // NOLINT
+    }
+
+    void* nil_gate_blob_owner(const nil_gate_blob* blob, void (*release)(void*))
+    {
+        const auto* storage = reinterpret_cast<const BlobStorage*>(blob); // NOLINT
+        return storage != nullptr && storage->release == release && release != nullptr
+            ? storage->owner
+            : nullptr;
+    }
+}
+
 namespace nil::gate::c
 {
     PortType::PortType(
@@ -13,6 +122,101 @@ namespace nil::gate::c
     {
     }
 
+    PortType PortType::from_i64(std::int64_t value)
+    {
+        auto port = PortType(nullptr, &nil_gate_port_eq_i64, &nil_gate_port_destroy_i64);
+        port.storage.i64 = value;
+        port.value = &port.storage;
+        return port;
+    }
+
+    PortType PortType::from_f64(double value)
+    {
+        auto port = PortType(nullptr, &nil_gate_port_eq_f64, &nil_gate_port_destroy_f64);
+        port.storage.f64 = value;
+        port.value = &port.storage;
+        return port;
+    }
+
+    PortType PortType::from_bool(int value)
+    {
+        auto port = PortType(nullptr, &nil_gate_port_eq_bool, &nil_gate_port_destroy_bool);
+        port.storage.boolean = value != 0 ? 1 : 0;
+        port.value = &port.storage;
+        return port;
+    }
+
+    PortType PortType::from_blob(const void* data, std::size_t size)
+    {
+        // single allocation: the storage followed by the bytes
+        auto* storage = allocate_blob(size);
+        auto* bytes = reinterpret_cast<unsigned char*>(storage + 1); // NOLINT
+        if (size > 0)
+        {
+            std::memcpy(bytes, data, size);
+        }
+        storage->blob = {.size = size, .data = bytes};
+        storage->owner = nullptr;
+        storage->release = nullptr;
+        return PortType(storage, &nil_gate_port_eq_blob, &nil_gate_port_destroy_blob);
+    }
+
+    PortType PortType::from_blob_ref(
+        const void* data,
+        std::size_t size,
+        void* owner,
+        void (*release)(void*)
+    )
+    {
+        BlobStorage* storage = nullptr;
+        try
+        {
+            storage = allocate_blob(0);
+        }
+        catch (...)
+        {
+            // ownership was handed over
+            if (release != nullptr)
+            {
+                release(owner);
+            }
+            throw;
+        }
+        storage->blob = {.size = size, .data = data};
+        storage->owner = owner;
+        storage->release = release;
+        return PortType(storage, &nil_gate_port_eq_blob, &nil_gate_port_destroy_blob);
+    }
+
+    PortType PortType::from_value(
+        void* value,
+        int (*eq)(const void*, const void*),
+        void (*destroy)(void*)
+    )
+    {
+        if (value != nullptr)
+        {
+            if (eq == &nil_gate_port_eq_i64)
+            {
+                return from_i64(*static_cast<const std::int64_t*>(value));
+            }
+            if (eq == &nil_gate_port_eq_f64)
+            {
+                return from_f64(*static_cast<const double*>(value));
+            }
+            if (eq == &nil_gate_port_eq_bool)
+            {
+                return from_bool(*static_cast<const int*>(value));
+            }
+            if (eq == &nil_gate_port_eq_blob)
+            {
+                const auto* blob = static_cast<const nil_gate_blob*>(value);
+                return from_blob(blob->data, blob->size);
+            }
+        }
+        return PortType(value, eq, destroy);
+    }
+
     PortType::PortType(PortType&& o) noexcept
     {
         *this = std::move(o);
@@ -32,7 +236,9 @@ namespace nil::gate::c
 
         eq = o.eq;
         destroy = o.destroy;
-        value = o.value;
+        storage = o.storage;
+        // inline values point to the storage of their owner
+        value = o.value == &o.storage ? &storage : o.value;
         o.value = nullptr;
         return *this;
     }
@@ -65,8 +271,9 @@ namespace nil::gate::traits
 
     void Port<c::PortType>::unset(std::optional<c::PortType>& value)
     {
-        if (value.has_value())
+        if (value.has_value() && value->value != nullptr)
         {
+            value->destroy(value->value);
             value->value = nullptr;
         }
     }
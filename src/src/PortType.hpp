@@ -2,6 +2,9 @@
 
 #include <nil/gate.hpp>
 
+#include <cstddef>
+#include <cstdint>
+
 namespace nil::gate::c
 {
     struct PortType final
@@ -10,12 +13,39 @@ namespace nil::gate::c
         int (*eq)(const void*, const void*) = nullptr;
         void (*destroy)(void*) = nullptr;
 
+        // inline storage of the built-in scalar kinds. `value` points to it when used.
+        union
+        {
+            std::int64_t i64;
+            double f64;
+            int boolean;
+        } storage = {};
+
         explicit PortType(
             void* init_value,
             int (*init_eq)(const void*, const void*),
             void (*init_destroy)(void*)
         );
 
+        static PortType from_i64(std::int64_t value);
+        static PortType from_f64(double value);
+        static PortType from_bool(int value);
+        static PortType from_blob(const void* data, std::size_t size);
+        // borrows `data`. `release(owner)` is called once the value is no longer used.
+        static PortType from_blob_ref(
+            const void* data,
+            std::size_t size,
+            void* owner,
+            void (*release)(void*)
+        );
+
+        // built-in kinds (matched by `eq`) copy the pointee, anything else is owned as is
+        static PortType from_value(
+            void* value,
+            int (*eq)(const void*, const void*),
+            void (*destroy)(void*)
+        );
+
         PortType(const PortType& o) = delete;
         PortType& operator=(const PortType& o) = delete;
         PortType(PortType&& o) noexcept;
@@ -1,13 +1,98 @@
 #include <nil/gate.h>
 #include <nil/gate.hpp>
+#include <nil/gate/Batch.hpp>
+#include <nil/gate/probes/Latency.hpp>
+#include <nil/gate/probes/Multi.hpp>
 #include <nil/gate/runners/Async.hpp>
 #include <nil/gate/runners/Immediate.hpp>
 #include <nil/gate/runners/SoftBlocking.hpp>
 
 #include <nil/xalt/raii.hpp>
 
+#include "HostRunner.hpp"
 #include "PortType.hpp"
 
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    // probes installed through the C API, added to the probe already set on the core
+    struct CoreProbes
+    {
+        nil::gate::probes::Multi multi;
+        nil::gate::IProbe* latency = nullptr;
+    };
+
+    std::mutex core_probes_mutex;                                 // NOLINT
+    std::unordered_map<nil::gate::Core*, CoreProbes> core_probes; // NOLINT
+
+    // nil_gate_task_queue. shared by the host and the executors made from it.
+    struct TaskQueue
+    {
+        using Task = nil::gate::runners::Async::Task;
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::vector<Task> tasks;
+        bool closed = false;
+
+        void push(Task task)
+        {
+            {
+                const std::lock_guard lock(mutex);
+                if (closed)
+                {
+                    return;
+                }
+                tasks.push_back(std::move(task));
+            }
+            cv.notify_one();
+        }
+
+        std::vector<Task> take(std::chrono::milliseconds timeout)
+        {
+            std::unique_lock lock(mutex);
+            cv.wait_for(lock, timeout, [this]() { return !tasks.empty(); });
+            return std::exchange(tasks, {});
+        }
+
+        void close()
+        {
+            std::vector<Task> dropped;
+            const std::lock_guard lock(mutex);
+            closed = true;
+            std::swap(dropped, tasks);
+        }
+    };
+
+    using TaskQueuePtr = std::shared_ptr<TaskQueue>;
+
+    const nil::gate::probes::Histogram* latency_histogram(
+        const nil::gate::probes::Latency::Snapshot& snapshot,
+        nil_gate_latency_kind kind,
+        std::uint32_t level
+    )
+    {
+        switch (kind)
+        {
+            case NIL_GATE_LATENCY_QUEUE:
+                return &snapshot.queue;
+            case NIL_GATE_LATENCY_COMMIT:
+                return &snapshot.commit;
+            case NIL_GATE_LATENCY_LEVEL:
+                return level < snapshot.levels.size() ? &snapshot.levels[level] : nullptr;
+        }
+        return nullptr;
+    }
+}
+
 extern "C"
 {
     nil_gate_core nil_gate_core_create(void)
@@ -17,7 +102,10 @@ extern "C"
 
     void nil_gate_core_destroy(nil_gate_core core)
     {
-        delete static_cast<nil::gate::Core*>(core.handle); // NOLINT
+        auto* c = static_cast<nil::gate::Core*>(core.handle);
+        delete c; // NOLINT
+        const std::lock_guard lock(core_probes_mutex);
+        core_probes.erase(c);
     }
 
     void nil_gate_core_commit(nil_gate_core core)
@@ -44,6 +132,195 @@ extern "C"
         c->set_runner(new nil::gate::runners::Async(thread_count)); // NOLINT
     }
 
+    void nil_gate_task_run(nil_gate_task task)
+    {
+        auto* t = static_cast<nil::gate::runners::Async::Task*>(task.handle);
+        (*t)();
+        delete t; // NOLINT
+    }
+
+    void nil_gate_core_set_executor(nil_gate_core core, uint32_t tag, nil_gate_executor executor)
+    {
+        namespace ng = nil::gate;
+        auto holder = std::make_shared<nil::xalt::raii<void>>(executor.context, executor.cleanup);
+        auto* async = dynamic_cast<ng::runners::Async*>(static_cast<ng::Core*>(core.handle)->get_runner());
+        if (async == nullptr)
+        {
+            return;
+        }
+        if (executor.post == nullptr)
+        {
+            async->set_executor(tag, nullptr);
+            return;
+        }
+        async->set_executor(
+            tag,
+            [post = executor.post, holder = std::move(holder)](ng::runners::Async::Task task)
+            {
+                post({.handle = new ng::runners::Async::Task(std::move(task))}, holder->object); // NOLINT
+            }
+        );
+    }
+
+    nil_gate_task_queue nil_gate_task_queue_create(void)
+    {
+        return {.handle = new TaskQueuePtr(std::make_shared<TaskQueue>())}; // NOLINT
+    }
+
+    void nil_gate_task_queue_destroy(nil_gate_task_queue queue)
+    {
+        auto* q = static_cast<TaskQueuePtr*>(queue.handle);
+        (*q)->close();
+        delete q; // NOLINT
+    }
+
+    nil_gate_executor nil_gate_task_queue_executor(nil_gate_task_queue queue)
+    {
+        return {
+            .post = +[](nil_gate_task task, void* context)
+            {
+                auto* t = static_cast<TaskQueue::Task*>(task.handle);
+                (*static_cast<TaskQueuePtr*>(context))->push(std::move(*t));
+                delete t; // NOLINT
+            },
+            .context = new TaskQueuePtr(*static_cast<TaskQueuePtr*>(queue.handle)), // NOLINT
+            .cleanup = +[](void* context) { delete static_cast<TaskQueuePtr*>(context); } // NOLINT
+        };
+    }
+
+    size_t nil_gate_task_queue_run(nil_gate_task_queue queue, uint32_t timeout_ms)
+    {
+        auto tasks = (*static_cast<TaskQueuePtr*>(queue.handle))
+                         ->take(std::chrono::milliseconds(timeout_ms));
+        for (auto& task : tasks)
+        {
+            task();
+        }
+        return tasks.size();
+    }
+
+    nil_gate_latency nil_gate_latency_create(void)
+    {
+        return {.handle = new nil::gate::probes::Latency()}; // NOLINT
+    }
+
+    void nil_gate_latency_destroy(nil_gate_latency latency)
+    {
+        delete static_cast<nil::gate::probes::Latency*>(latency.handle); // NOLINT
+    }
+
+    void nil_gate_core_set_latency(nil_gate_core core, nil_gate_latency latency)
+    {
+        auto* c = static_cast<nil::gate::Core*>(core.handle);
+        auto* l = static_cast<nil::gate::probes::Latency*>(latency.handle);
+
+        const std::lock_guard lock(core_probes_mutex);
+        auto& entry = core_probes[c];
+        auto* current = c->get_probe();
+        if (current == entry.latency)
+        {
+            current = nullptr;
+        }
+
+        if (current == &entry.multi)
+        {
+            entry.multi.remove(entry.latency);
+            if (l != nullptr)
+            {
+                entry.multi.add(l);
+            }
+        }
+        else if (current == nullptr)
+        {
+            c->set_probe(l);
+        }
+        else if (l != nullptr)
+        {
+            entry.multi = nil::gate::probes::Multi({current, l});
+            c->set_probe(&entry.multi);
+        }
+        entry.latency = l;
+    }
+
+    uint32_t nil_gate_latency_levels(nil_gate_latency latency)
+    {
+        const auto snapshot = static_cast<nil::gate::probes::Latency*>(latency.handle)->snapshot();
+        return uint32_t(snapshot.levels.size());
+    }
+
+    nil_gate_latency_summary nil_gate_latency_get(
+        nil_gate_latency latency,
+        nil_gate_latency_kind kind,
+        uint32_t level
+    )
+    {
+        const auto snapshot = static_cast<nil::gate::probes::Latency*>(latency.handle)->snapshot();
+        const auto* h = latency_histogram(snapshot, kind, level);
+        if (h == nullptr || h->count() == 0)
+        {
+            return {};
+        }
+        return {
+            .count = h->count(),
+            .min = uint64_t(h->min().count()),
+            .max = uint64_t(h->max().count()),
+            .mean = uint64_t(h->mean().count()),
+            .p50 = uint64_t(h->percentile(50.0).count()),
+            .p90 = uint64_t(h->percentile(90.0).count()),
+            .p99 = uint64_t(h->percentile(99.0).count()),
+            .p999 = uint64_t(h->percentile(99.9).count()),
+            .p9999 = uint64_t(h->percentile(99.99).count()),
+        };
+    }
+
+    uint64_t nil_gate_latency_percentile(
+        nil_gate_latency latency,
+        nil_gate_latency_kind kind,
+        uint32_t level,
+        double percentile
+    )
+    {
+        const auto snapshot = static_cast<nil::gate::probes::Latency*>(latency.handle)->snapshot();
+        const auto* h = latency_histogram(snapshot, kind, level);
+        return h == nullptr ? 0 : uint64_t(h->percentile(percentile).count());
+    }
+
+    void nil_gate_latency_reset(nil_gate_latency latency)
+    {
+        static_cast<nil::gate::probes::Latency*>(latency.handle)->reset();
+    }
+
+    void nil_gate_core_set_runner_host(nil_gate_core core)
+    {
+        const auto c = static_cast<nil::gate::Core*>(core.handle); // NOLINT
+        delete c->get_runner();                                    // NOLINT
+        c->set_runner(new nil::gate::c::HostRunner());             // NOLINT
+    }
+
+    nil_gate_node_batch nil_gate_core_next(nil_gate_core core)
+    {
+        auto* host = dynamic_cast<nil::gate::c::HostRunner*>(
+            static_cast<nil::gate::Core*>(core.handle)->get_runner()
+        );
+        if (host == nullptr)
+        {
+            return {.size = 0, .args = nullptr};
+        }
+        const auto batch = host->next();
+        return {.size = batch.size(), .args = batch.data()};
+    }
+
+    void nil_gate_core_done(nil_gate_core core)
+    {
+        auto* host = dynamic_cast<nil::gate::c::HostRunner*>(
+            static_cast<nil::gate::Core*>(core.handle)->get_runner()
+        );
+        if (host != nullptr)
+        {
+            host->done();
+        }
+    }
+
     void nil_gate_core_unset_runner(nil_gate_core core)
     {
         const auto c = static_cast<nil::gate::Core*>(core.handle); // NOLINT
@@ -81,7 +358,11 @@ extern "C"
     {
         auto* handle
             = static_cast<nil::gate::Graph*>(graph.handle)
-                  ->port(nil::gate::c::PortType(initial_value, meta_info.eq, meta_info.destroy));
+                  ->port(nil::gate::c::PortType::from_value(
+                      initial_value,
+                      meta_info.eq,
+                      meta_info.destroy
+                  ));
         return nil_gate_eport{.handle = handle, .info = meta_info};
     }
 
@@ -103,7 +384,9 @@ extern "C"
     void nil_gate_mport_set_value(nil_gate_mport port, void* new_value)
     {
         static_cast<nil::gate::ports::Mutable<nil::gate::c::PortType>*>(port.handle)
-            ->set_value(nil::gate::c::PortType(new_value, port.info.eq, port.info.destroy));
+            ->set_value(
+                nil::gate::c::PortType::from_value(new_value, port.info.eq, port.info.destroy)
+            );
     }
 
     void nil_gate_mport_unset_value(nil_gate_mport port)
@@ -111,6 +394,221 @@ extern "C"
         static_cast<nil::gate::ports::Mutable<nil::gate::c::PortType>*>(port.handle)->unset_value();
     }
 
+    nil_gate_eport nil_gate_graph_port_i64(nil_gate_graph graph, int64_t initial_value)
+    {
+        auto* handle = static_cast<nil::gate::Graph*>(graph.handle)
+                           ->port(nil::gate::c::PortType::from_i64(initial_value));
+        return nil_gate_eport{
+            .handle = handle,
+            .info = {.eq = &nil_gate_port_eq_i64, .destroy = &nil_gate_port_destroy_i64},
+        };
+    }
+
+    nil_gate_eport nil_gate_graph_port_f64(nil_gate_graph graph, double initial_value)
+    {
+        auto* handle = static_cast<nil::gate::Graph*>(graph.handle)
+                           ->port(nil::gate::c::PortType::from_f64(initial_value));
+        return nil_gate_eport{
+            .handle = handle,
+            .info = {.eq = &nil_gate_port_eq_f64, .destroy = &nil_gate_port_destroy_f64},
+        };
+    }
+
+    nil_gate_eport nil_gate_graph_port_bool(nil_gate_graph graph, int initial_value)
+    {
+        auto* handle = static_cast<nil::gate::Graph*>(graph.handle)
+                           ->port(nil::gate::c::PortType::from_bool(initial_value));
+        return nil_gate_eport{
+            .handle = handle,
+            .info = {.eq = &nil_gate_port_eq_bool, .destroy = &nil_gate_port_destroy_bool},
+        };
+    }
+
+    nil_gate_eport nil_gate_graph_port_blob(nil_gate_graph graph, const void* data, size_t size)
+    {
+        auto* handle = static_cast<nil::gate::Graph*>(graph.handle)
+                           ->port(nil::gate::c::PortType::from_blob(data, size));
+        return nil_gate_eport{
+            .handle = handle,
+            .info = {.eq = &nil_gate_port_eq_blob, .destroy = &nil_gate_port_destroy_blob},
+        };
+    }
+
+    void nil_gate_mport_set_i64(nil_gate_mport port, int64_t new_value)
+    {
+        static_cast<nil::gate::ports::Mutable<nil::gate::c::PortType>*>(port.handle)
+            ->set_value(nil::gate::c::PortType::from_i64(new_value));
+    }
+
+    void nil_gate_mport_set_f64(nil_gate_mport port, double new_value)
+    {
+        static_cast<nil::gate::ports::Mutable<nil::gate::c::PortType>*>(port.handle)
+            ->set_value(nil::gate::c::PortType::from_f64(new_value));
+    }
+
+    void nil_gate_mport_set_bool(nil_gate_mport port, int new_value)
+    {
+        static_cast<nil::gate::ports::Mutable<nil::gate::c::PortType>*>(port.handle)
+            ->set_value(nil::gate::c::PortType::from_bool(new_value));
+    }
+
+    void nil_gate_mport_set_blob(nil_gate_mport port, const void* data, size_t size)
+    {
+        static_cast<nil::gate::ports::Mutable<nil::gate::c::PortType>*>(port.handle)
+            ->set_value(nil::gate::c::PortType::from_blob(data, size));
+    }
+
+    nil_gate_eport nil_gate_graph_port_blob_ref(
+        nil_gate_graph graph,
+        const void* data,
+        size_t size,
+        void* owner,
+        void (*release)(void*)
+    )
+    {
+        auto* handle = static_cast<nil::gate::Graph*>(graph.handle)
+                           ->port(nil::gate::c::PortType::from_blob_ref(data, size, owner, release));
+        return nil_gate_eport{
+            .handle = handle,
+            .info = {.eq = &nil_gate_port_eq_blob, .destroy = &nil_gate_port_destroy_blob},
+        };
+    }
+
+    void nil_gate_mport_set_blob_ref(
+        nil_gate_mport port,
+        const void* data,
+        size_t size,
+        void* owner,
+        void (*release)(void*)
+    )
+    {
+        static_cast<nil::gate::ports::Mutable<nil::gate::c::PortType>*>(port.handle)
+            ->set_value(nil::gate::c::PortType::from_blob_ref(data, size, owner, release));
+    }
+
+    void nil_gate_mports_set_values(
+        const nil_gate_mport* ports,
+        void* const* new_values,
+        size_t count
+    )
+    {
+        nil_gate_mports_set_values_ref(ports, new_values, nullptr, nullptr, count);
+    }
+
+    void nil_gate_mports_set_values_ref(
+        const nil_gate_mport* ports,
+        void* const* new_values,
+        void* const* owners,
+        void (*release)(void*),
+        size_t count
+    )
+    {
+        namespace ng = nil::gate;
+        // staging buffer is kept per thread so repeated batches do not allocate
+        thread_local ng::Batch batch;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto& port = ports[i]; // NOLINT
+            auto* handle = static_cast<ng::ports::Mutable<ng::c::PortType>*>(port.handle);
+            if (new_values[i] == nullptr) // NOLINT
+            {
+                batch.unset_value(handle);
+            }
+            else if (owners != nullptr && owners[i] != nullptr) // NOLINT
+            {
+                const auto* blob = static_cast<const nil_gate_blob*>(new_values[i]); // NOLINT
+                batch.set_value(
+                    handle,
+                    ng::c::PortType::from_blob_ref(blob->data, blob->size, owners[i], release) // NOLINT
+                );
+            }
+            else
+            {
+                batch.set_value(
+                    handle,
+                    ng::c::PortType::from_value(new_values[i], port.info.eq, port.info.destroy) // NOLINT
+                );
+            }
+        }
+        batch.flush();
+    }
+
+    void nil_gate_mports_set_i64(const nil_gate_mport* ports, const int64_t* new_values, size_t count)
+    {
+        namespace ng = nil::gate;
+        thread_local ng::Batch batch;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            batch.set_value(
+                static_cast<ng::ports::Mutable<ng::c::PortType>*>(ports[i].handle), // NOLINT
+                ng::c::PortType::from_i64(new_values[i])                            // NOLINT
+            );
+        }
+        batch.flush();
+    }
+
+    void nil_gate_mports_set_f64(const nil_gate_mport* ports, const double* new_values, size_t count)
+    {
+        namespace ng = nil::gate;
+        thread_local ng::Batch batch;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            batch.set_value(
+                static_cast<ng::ports::Mutable<ng::c::PortType>*>(ports[i].handle), // NOLINT
+                ng::c::PortType::from_f64(new_values[i])                            // NOLINT
+            );
+        }
+        batch.flush();
+    }
+
+    void nil_gate_mports_set_bool(const nil_gate_mport* ports, const int* new_values, size_t count)
+    {
+        namespace ng = nil::gate;
+        thread_local ng::Batch batch;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            batch.set_value(
+                static_cast<ng::ports::Mutable<ng::c::PortType>*>(ports[i].handle), // NOLINT
+                ng::c::PortType::from_bool(new_values[i])                           // NOLINT
+            );
+        }
+        batch.flush();
+    }
+
+    void nil_gate_rports_values(const nil_gate_rport* ports, const void** values, size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            values[i] = nil_gate_rport_has_value(ports[i]) != 0 // NOLINT
+                ? nil_gate_rport_value(ports[i])              // NOLINT
+                : nullptr;
+        }
+    }
+
+    size_t nil_gate_rports_changed(
+        const nil_gate_rport* ports,
+        uint64_t* versions,
+        uint8_t* changed,
+        size_t count
+    )
+    {
+        size_t changed_count = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto version
+                = static_cast<nil::gate::ports::ReadOnly<nil::gate::c::PortType>*>(ports[i].handle) // NOLINT
+                      ->version();
+            const auto is_changed = versions[i] != version; // NOLINT
+            versions[i] = version;                          // NOLINT
+            if (changed != nullptr)
+            {
+                changed[i] = is_changed ? 1 : 0; // NOLINT
+            }
+            changed_count += is_changed ? 1 : 0;
+        }
+        return changed_count;
+    }
+
     nil_gate_node nil_gate_graph_node(nil_gate_graph graph, nil_gate_node_info node_info)
     {
         namespace ng = nil::gate;
@@ -139,38 +637,36 @@ extern "C"
         }();
 
         auto holder = std::make_shared<nil::xalt::raii<void>>(node_info.context, node_info.cleanup);
+        // argument buffers are allocated once per node and refreshed in place on every call
         auto ng_fn = [exec = node_info.exec,
                       holder = std::move(holder),
-                      ng_output_info = std::move(ng_output_info)] //
-            (const ng::UNode<ng::c::PortType>::Arg& arg) -> void
+                      ng_output_info = std::move(ng_output_info),
+                      arg_inputs = std::vector<const void*>(node_info.inputs.size),
+                      arg_outputs = std::vector<nil_gate_mport>(),
+                      args = nil_gate_node_args()] //
+            (const ng::UNode<ng::c::PortType>::Arg& arg) mutable -> void
         {
-            auto arg_inputs = [&]()
+            for (auto i = 0U; i < arg.inputs.size(); ++i)
             {
-                std::vector<const void*> object;
-                object.reserve(arg.inputs.size());
-                for (const auto& i : arg.inputs)
-                {
-                    object.push_back(i->value);
-                }
-                return object;
-            }();
+                arg_inputs[i] = arg.inputs[i]->value;
+            }
 
-            auto arg_outputs = [&]()
+            // output ports are owned by the node and never change
+            if (arg_outputs.size() != arg.outputs.size())
             {
-                std::vector<nil_gate_mport> object;
-                object.reserve(arg.outputs.size());
+                arg_outputs.reserve(arg.outputs.size());
                 for (auto i = 0U; i < arg.outputs.size(); ++i)
                 {
-                    object.push_back(
+                    arg_outputs.push_back(
                         nil_gate_mport{.handle = arg.outputs[i], .info = ng_output_info[i]}
                     );
                 }
-                return object;
-            }();
+            }
 
             auto ngc = nil_gate_core{.handle = arg.core};
 
-            auto args = nil_gate_node_args{
+            // kept alive by the node since host nodes are executed after this call returns
+            args = nil_gate_node_args{
                 .core = ngc,
                 .inputs = {
                     .size = static_cast<std::uint8_t>(arg.inputs.size()),
@@ -183,17 +679,37 @@ extern "C"
                 .context = holder->object
             };
 
-            exec(&args);
+            if (exec != nullptr)
+            {
+                exec(&args);
+            }
+            else if (auto* host = dynamic_cast<ng::c::HostRunner*>(arg.core->get_runner()))
+            {
+                host->defer(&args);
+            }
         };
 
-        return {
-            .handle = static_cast<nil::gate::Graph*>(graph.handle)
-                          ->unode<ng::c::PortType>(
-                              {.inputs = std::move(ng_inputs),
-                               .output_size = node_info.outputs.size,
-                               .fn = std::move(ng_fn)}
-                          )
-        };
+        auto* node = static_cast<nil::gate::Graph*>(graph.handle)
+                         ->unode<ng::c::PortType>(
+                             {.inputs = std::move(ng_inputs),
+                              .output_size = node_info.outputs.size,
+                              .fn = std::move(ng_fn)}
+                         );
+
+        // outputs start without a value but already carry their declared info
+        const auto outputs = node->outputs();
+        for (auto i = 0U; i < outputs.size(); ++i)
+        {
+            const auto& info = node_info.outputs.infos[i]; // NOLINT
+            static_cast<ng::detail::Port<ng::c::PortType>*>(outputs[i])
+                ->initialize(ng::c::PortType(nullptr, info.eq, info.destroy));
+        }
+        return {.handle = node};
+    }
+
+    void nil_gate_node_set_affinity(nil_gate_node node, uint32_t tag)
+    {
+        static_cast<nil::gate::UNode<nil::gate::c::PortType>*>(node.handle)->set_affinity(tag);
     }
 
     uint8_t nil_gate_node_output_size(nil_gate_node node)
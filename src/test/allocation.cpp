@@ -0,0 +1,209 @@
+#include <nil/gate.hpp>
+#include <nil/gate/runners/Async.hpp>
+#include <nil/gate/runners/Immediate.hpp>
+#include <nil/gate/runners/SoftBlocking.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+// counts every allocation made by any thread while `counting` is set.
+namespace
+{
+    std::atomic<bool> counting = false;        // NOLINT
+    std::atomic<std::size_t> allocations = 0U; // NOLINT
+
+    struct Counting
+    {
+        Counting()
+        {
+            allocations = 0U;
+            counting = true;
+        }
+
+        ~Counting() noexcept
+        {
+            counting = false;
+        }
+
+        Counting(Counting&&) = delete;
+        Counting(const Counting&) = delete;
+        Counting& operator=(Counting&&) = delete;
+        Counting& operator=(const Counting&) = delete;
+    };
+
+    constexpr auto warm_up = 16;
+    constexpr auto iterations = 1000;
+}
+
+// gcc flags free() on memory from the (replaced) operator new once both are inlined
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size)
+{
+    if (counting.load(std::memory_order_relaxed))
+    {
+        allocations.fetch_add(1U, std::memory_order_relaxed);
+    }
+    if (void* p = std::malloc(size == 0 ? 1 : size)) // NOLINT
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p); // NOLINT
+}
+
+void operator delete(void* p, std::size_t /* size */) noexcept
+{
+    std::free(p); // NOLINT
+}
+
+namespace
+{
+    struct Fixture
+    {
+        nil::gate::ports::External<int>* input = nullptr;
+        nil::gate::ports::External<int>* posted = nullptr;
+        std::atomic<int> last = 0;
+        std::atomic<bool> built = false;
+
+        void build(nil::gate::Core& core)
+        {
+            core.apply(
+                [this](nil::gate::Graph& graph)
+                {
+                    input = graph.port(0);
+                    posted = graph.port(0);
+                    auto [sum] = graph
+                                     .node(
+                                         [](int l, int r) { return l + r; },
+                                         {input, nil::gate::passive(posted)}
+                                     )
+                                     ->outputs();
+                    auto outs = graph
+                                    .unode<int>(
+                                        {.inputs = {sum, posted},
+                                         .output_size = 1,
+                                         .fn =
+                                             [](const nil::gate::UNode<int>::Arg& arg)
+                                         {
+                                             arg.outputs[0]->set_value(
+                                                 *arg.inputs[0] + *arg.inputs[1]
+                                             );
+                                         }}
+                                    )
+                                    ->outputs();
+                    graph.node([this](int v) { last = v; }, {outs[0]});
+                    built = true;
+                }
+            );
+            while (!built)
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        // conflated write, posted change and a commit
+        void commit(nil::gate::Core& core, nil::gate::Conflated<int>* feed, int i)
+        {
+            feed->set_value(i);
+            core.post([this, i]() { posted->to_direct()->set_value(i); });
+            core.commit();
+        }
+    };
+}
+
+TEST(allocation, immediate_commit)
+{
+    nil::gate::runners::Immediate runner;
+    nil::gate::Core core(&runner);
+
+    Fixture f;
+    f.build(core);
+    auto* feed = core.conflate(f.input);
+
+    for (auto i = 1; i <= warm_up; ++i)
+    {
+        f.commit(core, feed, i);
+    }
+
+    {
+        const Counting c;
+        for (auto i = warm_up + 1; i <= warm_up + iterations; ++i)
+        {
+            f.commit(core, feed, i);
+        }
+    }
+    ASSERT_EQ(f.last, (warm_up + iterations) * 3);
+    ASSERT_EQ(allocations, 0U);
+}
+
+TEST(allocation, soft_blocking_commit)
+{
+    nil::gate::runners::SoftBlocking runner;
+    nil::gate::Core core(&runner);
+
+    Fixture f;
+    f.build(core);
+    auto* feed = core.conflate(f.input);
+
+    for (auto i = 1; i <= warm_up; ++i)
+    {
+        f.commit(core, feed, i);
+    }
+
+    {
+        const Counting c;
+        for (auto i = warm_up + 1; i <= warm_up + iterations; ++i)
+        {
+            f.commit(core, feed, i);
+        }
+    }
+    ASSERT_EQ(f.last, (warm_up + iterations) * 3);
+    ASSERT_EQ(allocations, 0U);
+}
+
+TEST(allocation, async_commit)
+{
+    // runner is destroyed first so that no task is in flight when the core is destroyed
+    nil::gate::Core core;
+    nil::gate::runners::Async runner(2);
+    core.set_runner(&runner);
+
+    Fixture f;
+    f.build(core);
+    auto* feed = core.conflate(f.input);
+
+    const auto wait_for = [&f](int i)
+    {
+        while (f.last != i * 3)
+        {
+            std::this_thread::yield();
+        }
+    };
+
+    for (auto i = 1; i <= warm_up; ++i)
+    {
+        f.commit(core, feed, i);
+        wait_for(i);
+    }
+
+    {
+        const Counting c;
+        for (auto i = warm_up + 1; i <= warm_up + iterations; ++i)
+        {
+            f.commit(core, feed, i);
+            wait_for(i);
+        }
+    }
+    ASSERT_EQ(allocations, 0U);
+}
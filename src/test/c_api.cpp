@@ -0,0 +1,705 @@
+#include <nil/gate.h>
+#include <nil/gate/Core.hpp>
+#include <nil/gate/probes/Stats.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    template <typename T>
+    nil_gate_core_callable callable(void (*exec)(nil_gate_graph*, void*), T* context)
+    {
+        return {.exec = exec, .context = context, .cleanup = nullptr};
+    }
+
+    constexpr auto i64_info = nil_gate_port_info{
+        .eq = &nil_gate_port_eq_i64,
+        .destroy = &nil_gate_port_destroy_i64,
+    };
+
+    std::vector<std::vector<const nil_gate_node_args*>> drive(
+        nil_gate_core core,
+        void (*run)(const nil_gate_node_args*)
+    )
+    {
+        std::vector<std::vector<const nil_gate_node_args*>> batches;
+        for (auto batch = nil_gate_core_next(core); batch.size > 0;
+             batch = nil_gate_core_next(core))
+        {
+            batches.emplace_back(batch.args, batch.args + batch.size); // NOLINT
+            for (const auto* args : batches.back())
+            {
+                run(args);
+            }
+            nil_gate_core_done(core);
+        }
+        return batches;
+    }
+}
+
+TEST(c_api, kind_round_trip)
+{
+    struct State
+    {
+        nil_gate_eport i64;
+        nil_gate_eport f64;
+        nil_gate_eport boolean;
+        nil_gate_eport blob;
+    } s = {};
+
+    auto core = nil_gate_core_create();
+    nil_gate_core_set_runner_immediate(core);
+    nil_gate_core_apply(
+        core,
+        callable(
+            +[](nil_gate_graph* g, void* context)
+            {
+                auto* state = static_cast<State*>(context);
+                state->i64 = nil_gate_graph_port_i64(*g, -3);
+                state->f64 = nil_gate_graph_port_f64(*g, 0.5);
+                state->boolean = nil_gate_graph_port_bool(*g, 1);
+                state->blob = nil_gate_graph_port_blob(*g, "abc", 3);
+            },
+            &s
+        )
+    );
+
+    const auto value = [](nil_gate_eport port)
+    { return nil_gate_rport_value(nil_gate_eport_as_input(port)); };
+
+    ASSERT_EQ(*static_cast<const std::int64_t*>(value(s.i64)), -3);
+    ASSERT_EQ(*static_cast<const double*>(value(s.f64)), 0.5);
+    ASSERT_EQ(*static_cast<const int*>(value(s.boolean)), 1);
+    const auto* blob = static_cast<const nil_gate_blob*>(value(s.blob));
+    ASSERT_EQ(blob->size, 3);
+    ASSERT_EQ(std::memcmp(blob->data, "abc", 3), 0);
+
+    nil_gate_mport_set_i64(nil_gate_eport_to_direct(s.i64), 7);
+    nil_gate_mport_set_f64(nil_gate_eport_to_direct(s.f64), -1.25);
+    nil_gate_mport_set_bool(nil_gate_eport_to_direct(s.boolean), 0);
+    {
+        // copied, the buffer can go away right after the call
+        std::vector<char> bytes = {'x', 'y'};
+        nil_gate_mport_set_blob(nil_gate_eport_to_direct(s.blob), bytes.data(), bytes.size());
+    }
+    nil_gate_core_commit(core);
+
+    ASSERT_EQ(*static_cast<const std::int64_t*>(value(s.i64)), 7);
+    ASSERT_EQ(*static_cast<const double*>(value(s.f64)), -1.25);
+    ASSERT_EQ(*static_cast<const int*>(value(s.boolean)), 0);
+    blob = static_cast<const nil_gate_blob*>(value(s.blob));
+    ASSERT_EQ(blob->size, 2);
+    ASSERT_EQ(std::memcmp(blob->data, "xy", 2), 0);
+
+    nil_gate_core_unset_runner(core);
+    nil_gate_core_destroy(core);
+}
+
+TEST(c_api, batch_set_read_changed)
+{
+    struct State
+    {
+        std::array<nil_gate_eport, 3> ports;
+    } s = {};
+
+    auto core = nil_gate_core_create();
+    nil_gate_core_set_runner_immediate(core);
+    nil_gate_core_apply(
+        core,
+        callable(
+            +[](nil_gate_graph* g, void* context)
+            {
+                for (auto& port : static_cast<State*>(context)->ports)
+                {
+                    port = nil_gate_graph_port_i64(*g, 0);
+                }
+            },
+            &s
+        )
+    );
+
+    std::array<nil_gate_mport, 3> mports = {};
+    std::array<nil_gate_rport, 3> rports = {};
+    for (auto i = 0U; i < 3; ++i)
+    {
+        mports[i] = nil_gate_eport_to_direct(s.ports[i]);
+        rports[i] = nil_gate_eport_as_input(s.ports[i]);
+    }
+
+    std::array<std::uint64_t, 3> versions = {};
+    std::array<std::uint8_t, 3> changed = {};
+    nil_gate_rports_changed(rports.data(), versions.data(), nullptr, 3);
+
+    const std::array<std::int64_t, 3> values = {0, 5, 6};
+    nil_gate_mports_set_i64(mports.data(), values.data(), 3);
+    nil_gate_core_commit(core);
+
+    ASSERT_EQ(nil_gate_rports_changed(rports.data(), versions.data(), changed.data(), 3), 2);
+    ASSERT_EQ(changed, (std::array<std::uint8_t, 3>{0, 1, 1}));
+
+    std::array<const void*, 3> read = {};
+    nil_gate_rports_values(rports.data(), read.data(), 3);
+    ASSERT_EQ(*static_cast<const std::int64_t*>(read[1]), 5);
+    ASSERT_EQ(*static_cast<const std::int64_t*>(read[2]), 6);
+
+    // NULL unsets
+    const std::int64_t one = 1;
+    std::array<void*, 3> new_values = {const_cast<std::int64_t*>(&one), nullptr, nullptr};
+    nil_gate_mports_set_values(mports.data(), new_values.data(), 3);
+    nil_gate_core_commit(core);
+
+    ASSERT_EQ(nil_gate_rports_changed(rports.data(), versions.data(), changed.data(), 3), 3);
+    nil_gate_rports_values(rports.data(), read.data(), 3);
+    ASSERT_EQ(*static_cast<const std::int64_t*>(read[0]), 1);
+    ASSERT_EQ(read[1], nullptr);
+    ASSERT_EQ(read[2], nullptr);
+    ASSERT_EQ(nil_gate_rports_changed(rports.data(), versions.data(), changed.data(), 3), 0);
+
+    nil_gate_core_unset_runner(core);
+    nil_gate_core_destroy(core);
+}
+
+TEST(c_api, blob_ref_release)
+{
+    struct State
+    {
+        nil_gate_eport port;
+        std::vector<int> first = {1, 2};
+        int released = 0;
+    } s;
+
+    const auto release = +[](void* owner) { ++static_cast<State*>(owner)->released; };
+
+    auto core = nil_gate_core_create();
+    nil_gate_core_set_runner_immediate(core);
+    nil_gate_core_apply(
+        core,
+        callable(
+            +[](nil_gate_graph* g, void* context)
+            {
+                auto* state = static_cast<State*>(context);
+                state->port = nil_gate_graph_port_blob_ref(
+                    *g,
+                    state->first.data(),
+                    state->first.size() * sizeof(int),
+                    state,
+                    +[](void* owner) { ++static_cast<State*>(owner)->released; }
+                );
+            },
+            &s
+        )
+    );
+
+    const auto* blob = static_cast<const nil_gate_blob*>(
+        nil_gate_rport_value(nil_gate_eport_as_input(s.port))
+    );
+    ASSERT_EQ(blob->data, s.first.data());
+    ASSERT_EQ(s.released, 0);
+
+    // equal bytes are dropped right away
+    std::vector<int> same = {1, 2};
+    auto direct = nil_gate_eport_to_direct(s.port);
+    nil_gate_mport_set_blob_ref(direct, same.data(), same.size() * sizeof(int), &s, release);
+    nil_gate_core_commit(core);
+    ASSERT_EQ(s.released, 1);
+
+    std::vector<int> other = {3};
+    nil_gate_mport_set_blob_ref(direct, other.data(), other.size() * sizeof(int), &s, release);
+    nil_gate_core_commit(core);
+    ASSERT_EQ(s.released, 2);
+    blob = static_cast<const nil_gate_blob*>(
+        nil_gate_rport_value(nil_gate_eport_as_input(s.port))
+    );
+    ASSERT_EQ(blob->data, other.data());
+
+    nil_gate_core_unset_runner(core);
+    nil_gate_core_destroy(core);
+    ASSERT_EQ(s.released, 3);
+}
+
+TEST(c_api, host_batches_by_score)
+{
+    // a -> [double] -> b --+
+    //   -> [negate] -> c --+-> [sum] -> d
+    struct State
+    {
+        nil_gate_eport a;
+        nil_gate_rport d;
+    } s = {};
+
+    static int tag_double = 0;
+    static int tag_negate = 0;
+    static int tag_sum = 0;
+
+    auto core = nil_gate_core_create();
+    nil_gate_core_set_runner_host(core);
+    nil_gate_core_apply(
+        core,
+        callable(
+            +[](nil_gate_graph* g, void* context)
+            {
+                auto* state = static_cast<State*>(context);
+                state->a = nil_gate_graph_port_i64(*g, 2);
+                const std::array<nil_gate_rport, 1> a = {nil_gate_eport_as_input(state->a)};
+                const std::array<nil_gate_port_info, 1> out = {i64_info};
+
+                std::array<nil_gate_rport, 2> b_c = {};
+                auto b = nil_gate_graph_node(
+                    *g,
+                    {.exec = nullptr,
+                     .inputs = {1, a.data()},
+                     .outputs = {1, out.data()},
+                     .context = &tag_double,
+                     .cleanup = nullptr}
+                );
+                nil_gate_node_outputs(b, &b_c[0]);
+                auto c = nil_gate_graph_node(
+                    *g,
+                    {.exec = nullptr,
+                     .inputs = {1, a.data()},
+                     .outputs = {1, out.data()},
+                     .context = &tag_negate,
+                     .cleanup = nullptr}
+                );
+                nil_gate_node_outputs(c, &b_c[1]);
+                auto d = nil_gate_graph_node(
+                    *g,
+                    {.exec = nullptr,
+                     .inputs = {2, b_c.data()},
+                     .outputs = {1, out.data()},
+                     .context = &tag_sum,
+                     .cleanup = nullptr}
+                );
+                nil_gate_node_outputs(d, &state->d);
+            },
+            &s
+        )
+    );
+
+    const auto run = +[](const nil_gate_node_args* args)
+    {
+        const auto input = [args](int i)
+        { return *static_cast<const std::int64_t*>(args->inputs.data[i]); }; // NOLINT
+        auto output = args->outputs.ports[0];
+        if (args->context == &tag_double)
+        {
+            nil_gate_mport_set_i64(output, input(0) * 2);
+        }
+        else if (args->context == &tag_negate)
+        {
+            nil_gate_mport_set_i64(output, -input(0));
+        }
+        else
+        {
+            nil_gate_mport_set_i64(output, input(0) + input(1) + 100);
+        }
+    };
+
+    const auto d = [&s]() { return *static_cast<const std::int64_t*>(nil_gate_rport_value(s.d)); };
+
+    auto batches = drive(core, run);
+    ASSERT_EQ(batches.size(), 2);
+    ASSERT_EQ(batches[0].size(), 2);
+    ASSERT_EQ(batches[1].size(), 1);
+    ASSERT_EQ(batches[1][0]->context, &tag_sum);
+    ASSERT_EQ(d(), 102);
+
+    // nothing changed, nothing to run
+    nil_gate_core_commit(core);
+    ASSERT_TRUE(drive(core, run).empty());
+
+    nil_gate_mport_set_i64(nil_gate_eport_to_direct(s.a), 5);
+    nil_gate_core_commit(core);
+    batches = drive(core, run);
+    ASSERT_EQ(batches.size(), 2);
+    ASSERT_EQ(d(), 105);
+
+    nil_gate_core_unset_runner(core);
+    nil_gate_core_destroy(core);
+}
+
+TEST(c_api, host_commit_from_node)
+{
+    // a -> [count] -> b, the node feeds `a` back until it reaches 3
+    struct State
+    {
+        nil_gate_eport a;
+        nil_gate_rport b;
+    } s = {};
+
+    auto core = nil_gate_core_create();
+    nil_gate_core_set_runner_host(core);
+    nil_gate_core_apply(
+        core,
+        callable(
+            +[](nil_gate_graph* g, void* context)
+            {
+                auto* state = static_cast<State*>(context);
+                state->a = nil_gate_graph_port_i64(*g, 0);
+                const std::array<nil_gate_rport, 1> a = {nil_gate_eport_as_input(state->a)};
+                const std::array<nil_gate_port_info, 1> out = {i64_info};
+                auto node = nil_gate_graph_node(
+                    *g,
+                    {.exec = nullptr,
+                     .inputs = {1, a.data()},
+                     .outputs = {1, out.data()},
+                     .context = state,
+                     .cleanup = nullptr}
+                );
+                nil_gate_node_outputs(node, &state->b);
+            },
+            &s
+        )
+    );
+
+    const auto batches = drive(
+        core,
+        +[](const nil_gate_node_args* args)
+        {
+            const auto value = *static_cast<const std::int64_t*>(args->inputs.data[0]);
+            nil_gate_mport_set_i64(args->outputs.ports[0], value * 10);
+            if (value < 3)
+            {
+                // ports outside of the node are changed through the core
+                nil_gate_core_post(
+                    args->core,
+                    callable(
+                        +[](nil_gate_graph* /* g */, void* context)
+                        {
+                            const auto* node_state = static_cast<State*>(context);
+                            const auto* a = static_cast<const std::int64_t*>(
+                                nil_gate_rport_value(nil_gate_eport_as_input(node_state->a))
+                            );
+                            nil_gate_mport_set_i64(nil_gate_eport_to_direct(node_state->a), *a + 1);
+                        },
+                        static_cast<State*>(args->context)
+                    )
+                );
+                nil_gate_core_commit(args->core);
+            }
+        }
+    );
+
+    // the commits are picked up by the same drive loop
+    ASSERT_EQ(batches.size(), 4);
+    ASSERT_EQ(*static_cast<const std::int64_t*>(nil_gate_rport_value(s.b)), 30);
+
+    nil_gate_core_unset_runner(core);
+    nil_gate_core_destroy(core);
+}
+
+TEST(c_api, host_probe_timing)
+{
+    struct State
+    {
+        nil_gate_eport a;
+    } s = {};
+
+    auto core = nil_gate_core_create();
+    nil_gate_core_set_runner_host(core);
+    nil::gate::probes::Stats stats;
+    static_cast<nil::gate::Core*>(core.handle)->set_probe(&stats);
+
+    nil_gate_core_apply(
+        core,
+        callable(
+            +[](nil_gate_graph* g, void* context)
+            {
+                auto* state = static_cast<State*>(context);
+                state->a = nil_gate_graph_port_i64(*g, 0);
+                const std::array<nil_gate_rport, 1> a = {nil_gate_eport_as_input(state->a)};
+                nil_gate_graph_node(
+                    *g,
+                    {.exec = nullptr,
+                     .inputs = {1, a.data()},
+                     .outputs = {0, nullptr},
+                     .context = nullptr,
+                     .cleanup = nullptr}
+                );
+            },
+            &s
+        )
+    );
+
+    // the execution of a host node is the time the host spends on it
+    const auto batches = drive(
+        core,
+        +[](const nil_gate_node_args* /* args */)
+        { std::this_thread::sleep_for(std::chrono::milliseconds(5)); }
+    );
+    ASSERT_EQ(batches.size(), 1);
+
+    const auto snapshot = stats.snapshot();
+    ASSERT_EQ(snapshot.size(), 1);
+    ASSERT_EQ(snapshot[0].second.exec_count, 1);
+    ASSERT_GE(snapshot[0].second.total_time, std::chrono::milliseconds(5));
+
+    static_cast<nil::gate::Core*>(core.handle)->set_probe(nullptr);
+    nil_gate_core_unset_runner(core);
+    nil_gate_core_destroy(core);
+}
+
+TEST(c_api, executor_affinity)
+{
+    struct Queue
+    {
+        std::mutex mutex;
+        std::vector<nil_gate_task> tasks;
+        int cleaned = 0;
+    } q;
+
+    struct State
+    {
+        std::atomic<bool> built = false;
+        nil_gate_eport a;
+        std::thread::id thread;
+        std::atomic<std::int64_t> last = 0;
+    } s;
+
+    auto core = nil_gate_core_create();
+    nil_gate_core_set_runner_async(core, 2);
+    nil_gate_core_set_executor(
+        core,
+        1,
+        {.post =
+             +[](nil_gate_task task, void* context)
+             {
+                 auto* queue = static_cast<Queue*>(context);
+                 const std::lock_guard lock(queue->mutex);
+                 queue->tasks.push_back(task);
+             },
+         .context = &q,
+         .cleanup = +[](void* context) { ++static_cast<Queue*>(context)->cleaned; }}
+    );
+    nil_gate_core_apply(
+        core,
+        callable(
+            +[](nil_gate_graph* g, void* context)
+            {
+                auto* state = static_cast<State*>(context);
+                state->a = nil_gate_graph_port(*g, i64_info, nullptr);
+                const std::array<nil_gate_rport, 1> a = {nil_gate_eport_as_input(state->a)};
+                auto node = nil_gate_graph_node(
+                    *g,
+                    {.exec =
+                         +[](const nil_gate_node_args* args)
+                         {
+                             auto* node_state = static_cast<State*>(args->context);
+                             node_state->thread = std::this_thread::get_id();
+                             node_state->last
+                                 = *static_cast<const std::int64_t*>(args->inputs.data[0]);
+                         },
+                     .inputs = {1, a.data()},
+                     .outputs = {0, nullptr},
+                     .context = state,
+                     .cleanup = nullptr}
+                );
+                nil_gate_node_set_affinity(node, 1);
+                state->built = true;
+            },
+            &s
+        )
+    );
+    while (!s.built)
+    {
+        std::this_thread::yield();
+    }
+
+    for (std::int64_t i = 1; i <= 3; ++i)
+    {
+        nil_gate_mport_set_i64(nil_gate_eport_to_direct(s.a), i);
+        nil_gate_core_commit(core);
+        while (s.last != i)
+        {
+            std::vector<nil_gate_task> tasks;
+            {
+                const std::lock_guard lock(q.mutex);
+                tasks.swap(q.tasks);
+            }
+            for (auto task : tasks)
+            {
+                nil_gate_task_run(task);
+            }
+            std::this_thread::yield();
+        }
+        ASSERT_EQ(s.thread, std::this_thread::get_id());
+    }
+
+    nil_gate_core_unset_runner(core);
+    nil_gate_core_destroy(core);
+    ASSERT_EQ(q.cleaned, 1);
+}
+
+TEST(c_api, executor_task_queue)
+{
+    struct State
+    {
+        std::atomic<bool> built = false;
+        nil_gate_eport a;
+        std::thread::id thread;
+        std::int64_t last = 0;
+    } s;
+
+    auto core = nil_gate_core_create();
+    nil_gate_core_set_runner_async(core, 2);
+    auto queue = nil_gate_task_queue_create();
+    nil_gate_core_set_executor(core, 1, nil_gate_task_queue_executor(queue));
+    nil_gate_core_apply(
+        core,
+        callable(
+            +[](nil_gate_graph* g, void* context)
+            {
+                auto* state = static_cast<State*>(context);
+                state->a = nil_gate_graph_port_i64(*g, 0);
+                const std::array<nil_gate_rport, 1> a = {nil_gate_eport_as_input(state->a)};
+                auto node = nil_gate_graph_node(
+                    *g,
+                    {.exec =
+                         +[](const nil_gate_node_args* args)
+                         {
+                             auto* node_state = static_cast<State*>(args->context);
+                             node_state->thread = std::this_thread::get_id();
+                             node_state->last
+                                 = *static_cast<const std::int64_t*>(args->inputs.data[0]);
+                         },
+                     .inputs = {1, a.data()},
+                     .outputs = {0, nullptr},
+                     .context = state,
+                     .cleanup = nullptr}
+                );
+                nil_gate_node_set_affinity(node, 1);
+                state->built = true;
+            },
+            &s
+        )
+    );
+    while (!s.built)
+    {
+        std::this_thread::yield();
+    }
+    // the first pass ran the node with the initial value
+    while (nil_gate_task_queue_run(queue, 1000) == 0)
+    {
+    }
+    ASSERT_EQ(s.thread, std::this_thread::get_id());
+
+    nil_gate_core_apply(
+        core,
+        callable(
+            +[](nil_gate_graph* /* g */, void* context)
+            {
+                auto* state = static_cast<State*>(context);
+                nil_gate_mport_set_i64(nil_gate_eport_to_direct(state->a), 5);
+            },
+            &s
+        )
+    );
+    while (s.last != 5)
+    {
+        nil_gate_task_queue_run(queue, 1000);
+    }
+    ASSERT_EQ(s.thread, std::this_thread::get_id());
+    ASSERT_EQ(nil_gate_task_queue_run(queue, 0), 0U);
+
+    nil_gate_core_unset_runner(core);
+    nil_gate_task_queue_destroy(queue);
+    nil_gate_core_destroy(core);
+}
+
+TEST(c_api, latency)
+{
+    auto core = nil_gate_core_create();
+    nil_gate_core_set_runner_immediate(core);
+    auto latency = nil_gate_latency_create();
+    nil_gate_core_set_latency(core, latency);
+
+    for (auto i = 0; i < 10; ++i)
+    {
+        nil_gate_core_commit(core);
+    }
+
+    const auto queue = nil_gate_latency_get(latency, NIL_GATE_LATENCY_QUEUE, 0);
+    const auto commit = nil_gate_latency_get(latency, NIL_GATE_LATENCY_COMMIT, 0);
+    ASSERT_EQ(queue.count, 10);
+    ASSERT_EQ(commit.count, 10);
+    ASSERT_LE(commit.min, commit.p50);
+    ASSERT_LE(commit.p50, commit.max);
+    ASSERT_GE(nil_gate_latency_percentile(latency, NIL_GATE_LATENCY_COMMIT, 0, 100.0), commit.max);
+
+    nil_gate_latency_reset(latency);
+    ASSERT_EQ(nil_gate_latency_get(latency, NIL_GATE_LATENCY_COMMIT, 0).count, 0);
+
+    nil_gate_core_set_latency(core, {.handle = nullptr});
+    nil_gate_latency_destroy(latency);
+    nil_gate_core_unset_runner(core);
+    nil_gate_core_destroy(core);
+}
+
+TEST(c_api, latency_keeps_probe)
+{
+    auto core = nil_gate_core_create();
+    nil_gate_core_set_runner_immediate(core);
+    auto* c = static_cast<nil::gate::Core*>(core.handle);
+    nil::gate::probes::Stats stats;
+    c->set_probe(&stats);
+
+    struct State
+    {
+        nil_gate_eport a;
+    } s = {};
+
+    auto first = nil_gate_latency_create();
+    auto second = nil_gate_latency_create();
+    nil_gate_core_set_latency(core, first);
+    nil_gate_core_apply(
+        core,
+        callable(
+            +[](nil_gate_graph* g, void* context)
+            {
+                auto* state = static_cast<State*>(context);
+                state->a = nil_gate_graph_port_i64(*g, 0);
+                const std::array<nil_gate_rport, 1> a = {nil_gate_eport_as_input(state->a)};
+                nil_gate_graph_node(
+                    *g,
+                    {.exec = +[](const nil_gate_node_args* /* args */) {},
+                     .inputs = {1, a.data()},
+                     .outputs = {0, nullptr},
+                     .context = nullptr,
+                     .cleanup = nullptr}
+                );
+            },
+            &s
+        )
+    );
+    ASSERT_EQ(stats.snapshot().size(), 1);
+    ASSERT_EQ(nil_gate_latency_get(first, NIL_GATE_LATENCY_COMMIT, 0).count, 1);
+
+    // replaces the previous latency only
+    nil_gate_core_set_latency(core, second);
+    nil_gate_mport_set_i64(nil_gate_eport_to_direct(s.a), 1);
+    nil_gate_core_commit(core);
+    ASSERT_EQ(stats.snapshot()[0].second.exec_count, 2);
+    ASSERT_EQ(nil_gate_latency_get(first, NIL_GATE_LATENCY_COMMIT, 0).count, 1);
+    ASSERT_EQ(nil_gate_latency_get(second, NIL_GATE_LATENCY_COMMIT, 0).count, 1);
+
+    nil_gate_core_set_latency(core, {.handle = nullptr});
+    nil_gate_mport_set_i64(nil_gate_eport_to_direct(s.a), 2);
+    nil_gate_core_commit(core);
+    ASSERT_EQ(stats.snapshot()[0].second.exec_count, 3);
+    ASSERT_EQ(nil_gate_latency_get(second, NIL_GATE_LATENCY_COMMIT, 0).count, 1);
+
+    c->set_probe(nullptr);
+    nil_gate_latency_destroy(first);
+    nil_gate_latency_destroy(second);
+    nil_gate_core_unset_runner(core);
+    nil_gate_core_destroy(core);
+}
@@ -1,9 +1,28 @@
 #include <nil/gate.hpp>
+#include <nil/gate/Batch.hpp>
+#include <nil/gate/Callable.hpp>
+#include <nil/gate/Topology.hpp>
+#include <nil/gate/probes/Latency.hpp>
+#include <nil/gate/probes/Multi.hpp>
+#include <nil/gate/probes/Provenance.hpp>
+#include <nil/gate/probes/Stats.hpp>
+#include <nil/gate/probes/Trace.hpp>
+#include <nil/gate/probes/Watchdog.hpp>
+#include <nil/gate/runners/Async.hpp>
 #include <nil/gate/runners/SoftBlocking.hpp>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
 TEST(gate, create_port_uninit)
 {
     nil::gate::runners::SoftBlocking runner;
@@ -313,3 +332,999 @@ TEST(gate, link_set_value_in_post)
     ASSERT_EQ(dst_port->to_direct()->value(), 3);
     ASSERT_EQ(out->value(), 6);
 }
+
+TEST(gate, passive_input)
+{
+    nil::gate::runners::SoftBlocking runner;
+    nil::gate::Core core(&runner);
+
+    const testing::InSequence seq;
+    testing::StrictMock<testing::MockFunction<void(int, int)>> foo;
+
+    nil::gate::ports::External<int>* active = nullptr;
+    nil::gate::ports::External<int>* config = nullptr;
+
+    EXPECT_CALL(foo, Call(1, 10)).Times(1).RetiresOnSaturation();
+    core.apply(
+        [&](nil::gate::Graph& graph)
+        {
+            active = graph.port(1);
+            config = graph.port(10);
+            graph.node(
+                [&foo](int a, int c) { foo.Call(a, c); },
+                {active, nil::gate::passive(config)}
+            );
+        }
+    );
+
+    // changing the passive input alone does not re-execute the node
+    core.apply([mport = config->to_direct()]() { mport->set_value(20); });
+
+    // changing the active input re-executes with the latest passive value
+    EXPECT_CALL(foo, Call(2, 20)).Times(1).RetiresOnSaturation();
+    core.apply([mport = active->to_direct()]() { mport->set_value(2); });
+
+    // passive inputs still gate readiness
+    core.apply(
+        [mconfig = config->to_direct(), mactive = active->to_direct()]()
+        {
+            mconfig->unset_value();
+            mactive->set_value(3);
+        }
+    );
+
+    EXPECT_CALL(foo, Call(3, 30)).Times(1).RetiresOnSaturation();
+    core.apply([mport = config->to_direct()]() { mport->set_value(30); });
+}
+
+TEST(gate, lens_input)
+{
+    struct State
+    {
+        int position;
+        std::string label;
+
+        bool operator==(const State&) const = default;
+    };
+
+    nil::gate::runners::SoftBlocking runner;
+    nil::gate::Core core(&runner);
+
+    const testing::InSequence seq;
+    testing::StrictMock<testing::MockFunction<void(int)>> foo;
+
+    nil::gate::ports::External<State>* state = nullptr;
+
+    EXPECT_CALL(foo, Call(1)).Times(1).RetiresOnSaturation();
+    core.apply(
+        [&](nil::gate::Graph& graph)
+        {
+            state = graph.port(State{1, "a"});
+            graph.node([&foo](int p) { foo.Call(p); }, {nil::gate::lens<&State::position>(state)});
+        }
+    );
+
+    // other field changed, node does not re-execute
+    core.apply([mport = state->to_direct()]() { mport->set_value(State{1, "b"}); });
+
+    // projected field changed
+    EXPECT_CALL(foo, Call(2)).Times(1).RetiresOnSaturation();
+    core.apply([mport = state->to_direct()]() { mport->set_value(State{2, "b"}); });
+}
+
+TEST(gate, batch_set_value)
+{
+    nil::gate::runners::SoftBlocking runner;
+    nil::gate::Core core(&runner);
+
+    const testing::InSequence seq;
+    testing::StrictMock<testing::MockFunction<void(int, int, int)>> foo;
+
+    nil::gate::ports::External<int>* a = nullptr;
+    nil::gate::ports::External<int>* b = nullptr;
+    nil::gate::ports::External<int>* c = nullptr;
+
+    EXPECT_CALL(foo, Call(1, 2, 3)).Times(1).RetiresOnSaturation();
+    core.apply(
+        [&](nil::gate::Graph& graph)
+        {
+            a = graph.port(1);
+            b = graph.port(2);
+            c = graph.port<int>();
+            graph.node([&foo](int x, int y, int z) { foo.Call(x, y, z); }, {a, b, c});
+
+            nil::gate::Batch batch;
+            batch.set_value(c->to_direct(), 3);
+        }
+    );
+
+    EXPECT_CALL(foo, Call(10, 20, 30)).Times(1).RetiresOnSaturation();
+    core.apply(
+        [&]()
+        {
+            nil::gate::Batch batch(3);
+            batch.set_value(a->to_direct(), 5);
+            batch.set_value(a->to_direct(), 10);
+            batch.set_value(b->to_direct(), 20);
+            batch.set_value(c->to_direct(), 30);
+            ASSERT_EQ(a->to_direct()->value(), 10);
+            batch.flush();
+        }
+    );
+
+    // no actual change
+    core.apply(
+        [&]()
+        {
+            nil::gate::Batch batch;
+            batch.set_value(a->to_direct(), 10);
+            batch.set_value(b->to_direct(), 20);
+        }
+    );
+
+    core.apply(
+        [&]()
+        {
+            nil::gate::Batch batch;
+            batch.unset_value(c->to_direct());
+            batch.set_value(a->to_direct(), 11);
+        }
+    );
+    ASSERT_FALSE(c->to_direct()->has_value());
+}
+
+TEST(gate, port_version)
+{
+    nil::gate::runners::SoftBlocking runner;
+    nil::gate::Core core(&runner);
+
+    nil::gate::ports::External<int>* a = nullptr;
+    nil::gate::ports::ReadOnly<int>* out = nullptr;
+    core.apply(
+        [&](nil::gate::Graph& graph)
+        {
+            a = graph.port<int>();
+            std::tie(out) = graph.node([](int v) { return v * 2; }, {a})->outputs();
+        }
+    );
+    ASSERT_EQ(a->to_direct()->version(), 0U);
+    ASSERT_EQ(out->version(), 0U);
+
+    core.apply([&]() { a->to_direct()->set_value(1); });
+    ASSERT_EQ(a->to_direct()->version(), 1U);
+    ASSERT_EQ(out->version(), 1U);
+
+    // no actual change
+    core.apply([&]() { a->to_direct()->set_value(1); });
+    ASSERT_EQ(a->to_direct()->version(), 1U);
+    ASSERT_EQ(out->version(), 1U);
+
+    core.apply([&]() { a->to_direct()->unset_value(); });
+    ASSERT_EQ(a->to_direct()->version(), 2U);
+    ASSERT_EQ(out->version(), 1U);
+}
+
+TEST(gate, probe_stats)
+{
+    nil::gate::runners::SoftBlocking runner;
+    nil::gate::Core core(&runner);
+    nil::gate::probes::Stats stats;
+    core.set_probe(&stats);
+    ASSERT_EQ(core.get_probe(), &stats);
+
+    nil::gate::ports::External<int>* a = nullptr;
+    nil::gate::INode* half = nullptr;
+    nil::gate::INode* sink = nullptr;
+    core.apply(
+        [&](nil::gate::Graph& graph)
+        {
+            a = graph.port(2);
+            auto* h = graph.node([](int v) { return v / 2; }, {a});
+            half = h;
+            sink = graph.node([](int) {}, {get<0>(h->outputs())});
+        }
+    );
+
+    // same output, sink is cut off
+    core.apply([&]() { a->to_direct()->set_value(3); });
+
+    const auto h = stats.get(half);
+    ASSERT_EQ(h.exec_count, 2U);
+    ASSERT_EQ(h.skip_count, 0U);
+    ASSERT_EQ(h.eq_count, 2U);
+    ASSERT_EQ(h.change_count, 1U);
+    ASSERT_GE(h.total_time, h.max_time);
+
+    const auto s = stats.get(sink);
+    ASSERT_EQ(s.exec_count, 1U);
+    ASSERT_EQ(s.skip_count, 1U);
+    ASSERT_EQ(s.eq_count, 0U);
+    ASSERT_EQ(stats.snapshot().size(), 2U);
+
+    core.set_probe(nullptr);
+    core.apply([&]() { a->to_direct()->set_value(4); });
+    ASSERT_EQ(stats.get(half).exec_count, 2U);
+
+    stats.reset();
+    ASSERT_EQ(stats.get(half).exec_count, 0U);
+}
+
+TEST(gate, probe_stats_counters)
+{
+    using ESource = nil::gate::probes::Counters::ESource;
+
+    nil::gate::runners::SoftBlocking runner;
+    nil::gate::Core core(&runner);
+    nil::gate::probes::Stats stats(nil::gate::probes::Stats::ECounters::On);
+    core.set_probe(&stats);
+
+    nil::gate::INode* busy = nullptr;
+    core.apply(
+        [&](nil::gate::Graph& graph)
+        {
+            busy = graph.node(
+                [](int v)
+                {
+                    const auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(5);
+                    while (std::chrono::steady_clock::now() < until)
+                    {
+                    }
+                    return v;
+                },
+                {graph.port(1)}
+            );
+        }
+    );
+
+    const auto s = stats.get(busy);
+    ASSERT_EQ(s.exec_count, 1U);
+    const auto source = nil::gate::probes::Counters::this_thread().source();
+    if (source != ESource::None)
+    {
+        ASSERT_GT(s.counters.cpu_time, std::chrono::milliseconds(1));
+    }
+    if (source == ESource::Hardware)
+    {
+        ASSERT_GT(s.counters.cycles, 0U);
+        ASSERT_GT(s.counters.instructions, 0U);
+    }
+    else
+    {
+        ASSERT_EQ(s.counters.cycles, 0U);
+    }
+}
+
+TEST(gate, probe_provenance)
+{
+    nil::gate::runners::SoftBlocking runner;
+    nil::gate::Core core(&runner);
+    std::size_t reports = 0;
+    nil::gate::probes::Provenance provenance([&](const auto&) { ++reports; });
+    core.set_probe(&provenance);
+
+    nil::gate::ports::External<int>* a = nullptr;
+    nil::gate::ports::External<int>* b = nullptr;
+    nil::gate::INode* slow = nullptr;
+    nil::gate::INode* fast = nullptr;
+    nil::gate::INode* sink = nullptr;
+    core.apply(
+        [&](nil::gate::Graph& graph)
+        {
+            a = graph.port(1);
+            b = graph.port(1);
+            auto* s = graph.node(
+                [](int v)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                    return v;
+                },
+                {a}
+            );
+            auto* f = graph.node([](int v) { return v; }, {b});
+            slow = s;
+            fast = f;
+            sink = graph.node([](int, int) {}, {get<0>(s->outputs()), get<0>(f->outputs())});
+        }
+    );
+    ASSERT_EQ(reports, 1U);
+
+    const auto* pa = static_cast<const nil::gate::IPort*>(a->to_direct());
+    const auto* pb = static_cast<const nil::gate::IPort*>(b->to_direct());
+
+    core.apply([&]() { a->to_direct()->set_value(2); });
+    {
+        const auto report = provenance.last();
+        ASSERT_EQ(report.causes.size(), 2U);
+        ASSERT_EQ(report.causes[0].node, slow);
+        ASSERT_EQ(report.causes[1].node, sink);
+        ASSERT_EQ(report.causes[1].ports, std::vector<const nil::gate::IPort*>{pa});
+
+        ASSERT_EQ(report.critical_path.size(), 2U);
+        ASSERT_EQ(report.critical_path[0].node, slow);
+        ASSERT_EQ(report.critical_path[0].port, pa);
+        ASSERT_EQ(report.critical_path[1].node, sink);
+        ASSERT_GE(report.critical_path[1].cumulative, std::chrono::milliseconds(2));
+        ASSERT_EQ(
+            report.critical_path[1].cumulative,
+            report.critical_path[0].cumulative + report.critical_path[1].self
+        );
+    }
+
+    core.apply(
+        [&]()
+        {
+            a->to_direct()->set_value(3);
+            b->to_direct()->set_value(3);
+        }
+    );
+    {
+        const auto report = provenance.last();
+        ASSERT_EQ(report.causes.size(), 3U);
+        ASSERT_EQ(report.causes[2].node, sink);
+        ASSERT_EQ(report.causes[2].ports.size(), 2U);
+        const auto it = std::find_if(
+            report.causes.begin(),
+            report.causes.end(),
+            [&](const auto& c) { return c.node == fast; }
+        );
+        ASSERT_NE(it, report.causes.end());
+        ASSERT_EQ(it->ports, std::vector<const nil::gate::IPort*>{pb});
+        // through the slow node
+        ASSERT_EQ(report.critical_path.size(), 2U);
+        ASSERT_EQ(report.critical_path[0].node, slow);
+    }
+    ASSERT_EQ(reports, 3U);
+
+    const auto feeds = provenance.feeds();
+    ASSERT_EQ(feeds.size(), 2U);
+    ASSERT_EQ(feeds[0].first, pa);
+    ASSERT_EQ(feeds[0].second.changes, 2U);
+    ASSERT_EQ(feeds[0].second.executions, 4U);
+    ASSERT_GE(feeds[0].second.longest, std::chrono::milliseconds(2));
+    ASSERT_EQ(feeds[1].first, pb);
+    ASSERT_EQ(feeds[1].second.executions, 2U);
+
+    provenance.reset();
+    ASSERT_TRUE(provenance.feeds().empty());
+    ASSERT_TRUE(provenance.last().critical_path.empty());
+}
+
+TEST(gate, probe_watchdog)
+{
+    using Overrun = nil::gate::probes::Watchdog::Overrun;
+
+    std::mutex mutex;
+    std::vector<Overrun> overruns;
+    nil::gate::probes::Watchdog watchdog(
+        [&](const Overrun& o)
+        {
+            const std::lock_guard lock(mutex);
+            overruns.push_back(o);
+        }
+    );
+    watchdog.enable_shedding(true);
+
+    nil::gate::runners::SoftBlocking runner;
+    nil::gate::Core core(&runner);
+    core.set_probe(&watchdog);
+
+    nil::gate::ports::External<int>* delay = nullptr;
+    nil::gate::INode* slow = nullptr;
+    nil::gate::ports::ReadOnly<int>* low_out = nullptr;
+    std::vector<int> after_low;
+    core.apply(
+        [&](nil::gate::Graph& graph)
+        {
+            delay = graph.port(0);
+            slow = graph.node(
+                [](int ms)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+                    return ms;
+                },
+                {delay}
+            );
+            auto* low = graph.node([](int ms) { return ms; }, {delay});
+            low_out = get<0>(low->outputs());
+            graph.node([&](int v) { after_low.push_back(v); }, {low_out});
+            watchdog.set_budget(slow, std::chrono::milliseconds(5));
+            watchdog.set_sheddable(low, true);
+        }
+    );
+    ASSERT_TRUE(overruns.empty());
+
+    // reported by the monitor while still running
+    core.apply([&]() { delay->to_direct()->set_value(30); });
+    {
+        const std::lock_guard lock(mutex);
+        ASSERT_EQ(overruns.size(), 1U);
+        ASSERT_EQ(overruns[0].node, slow);
+        ASSERT_TRUE(overruns[0].running);
+        ASSERT_GT(overruns[0].elapsed, overruns[0].budget);
+    }
+    ASSERT_EQ(low_out->value(), 30);
+
+    // overloaded, `low` keeps its output
+    core.apply([&]() { delay->to_direct()->set_value(1); });
+    ASSERT_EQ(low_out->value(), 30);
+    ASSERT_EQ(watchdog.shed_count(), 1U);
+
+    // recovered, `low` catches up with the change it missed
+    core.commit();
+    ASSERT_EQ(low_out->value(), 1);
+    ASSERT_EQ(watchdog.shed_count(), 1U);
+    ASSERT_EQ(after_low, std::vector<int>({0, 30, 1}));
+
+    core.apply([&]() { delay->to_direct()->set_value(2); });
+    ASSERT_EQ(low_out->value(), 2);
+    ASSERT_EQ(watchdog.shed_count(), 1U);
+}
+
+TEST(gate, probe_trace)
+{
+    using testing::HasSubstr;
+    using testing::Not;
+
+    nil::gate::probes::Trace trace;
+    nil::gate::ports::External<int>* a = nullptr;
+    std::atomic<int> last = 0;
+    {
+        // runner is destroyed first so that no task is in flight when the core is destroyed
+        nil::gate::Core core;
+        nil::gate::runners::Async runner(2);
+        core.set_runner(&runner);
+        core.set_probe(&trace);
+
+        core.apply(
+            [&](nil::gate::Graph& graph)
+            {
+                a = graph.port(1);
+                auto* h = graph.node([](int v) { return v / 2; }, {a});
+                trace.set_name(h, "half \"x\"");
+                auto* n = graph.node([](int v) { return v + 1; }, {get<0>(h->outputs())});
+                // runs after `n`, once per commit
+                graph.node([&](int v, int) { last = v; }, {a, get<0>(n->outputs())});
+            }
+        );
+        const auto commit = [&](int v)
+        {
+            core.apply([&]() { a->to_direct()->set_value(v); });
+            while (last != v)
+            {
+                std::this_thread::yield();
+            }
+        };
+        commit(4);
+        // same output of `h`, `n` is cut off
+        commit(5);
+    }
+
+    std::ostringstream oss;
+    trace.write(oss);
+    const auto json = oss.str();
+    ASSERT_THAT(json, HasSubstr(R"("name":"commit")"));
+    ASSERT_THAT(json, HasSubstr(R"("name":"half \"x\"")"));
+    ASSERT_THAT(json, HasSubstr(R"("name":"node@)"));
+    ASSERT_THAT(json, HasSubstr(R"("cat":"skip")"));
+    ASSERT_THAT(json, HasSubstr(R"("wait_us":)"));
+    ASSERT_THAT(json, HasSubstr(R"("ph":"f")"));
+
+    trace.clear();
+    oss.str({});
+    trace.write(oss);
+    ASSERT_THAT(oss.str(), Not(HasSubstr(R"("ph":"X")")));
+}
+
+TEST(gate, latency_histogram)
+{
+    nil::gate::probes::Histogram h;
+    ASSERT_EQ(h.percentile(99.9).count(), 0);
+
+    for (auto i = 1; i <= 1000; ++i)
+    {
+        h.record(std::chrono::nanoseconds(i));
+    }
+    h.record(std::chrono::milliseconds(5));
+
+    ASSERT_EQ(h.count(), 1001);
+    ASSERT_EQ(h.min().count(), 1);
+    ASSERT_EQ(h.max(), std::chrono::milliseconds(5));
+    ASSERT_EQ(h.percentile(10.0).count(), 101); // exact below 128ns
+    ASSERT_NEAR(double(h.percentile(50.0).count()), 501.0, 501.0 / 64);
+    ASSERT_NEAR(double(h.percentile(99.0).count()), 991.0, 991.0 / 64);
+    ASSERT_EQ(h.percentile(100.0), std::chrono::milliseconds(5));
+
+    std::uint64_t total = 0;
+    h.for_each([&](auto lower, auto upper, std::uint64_t count)
+               {
+                   ASSERT_LE(lower, upper);
+                   total += count;
+               });
+    ASSERT_EQ(total, h.count());
+
+    nil::gate::probes::Histogram other;
+    other.record(std::chrono::seconds(1));
+    h.merge(other);
+    ASSERT_EQ(h.count(), 1002);
+    ASSERT_EQ(h.max(), std::chrono::seconds(1));
+
+    h.reset();
+    ASSERT_EQ(h.count(), 0);
+    ASSERT_EQ(h.min().count(), 0);
+}
+
+TEST(gate, probe_latency)
+{
+    nil::gate::probes::Latency latency;
+    nil::gate::ports::External<int>* a = nullptr;
+    std::atomic<int> last = 0;
+    {
+        // runner is destroyed first so that no task is in flight when the core is destroyed
+        nil::gate::Core core;
+        nil::gate::runners::Async runner(2);
+        core.set_runner(&runner);
+        core.set_probe(&latency);
+
+        core.apply(
+            [&](nil::gate::Graph& graph)
+            {
+                a = graph.port(1);
+                auto* n = graph.node([](int v) { return v + 1; }, {a});
+                graph.node([&](int v, int) { last = v; }, {a, get<0>(n->outputs())});
+            }
+        );
+        for (auto v = 2; v <= 4; ++v)
+        {
+            core.apply([&]() { a->to_direct()->set_value(v); });
+            while (last != v)
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    const auto snapshot = latency.snapshot();
+    ASSERT_EQ(snapshot.queue.count(), 4);
+    ASSERT_GE(snapshot.commit.count(), 3);
+    // level 0 holds the nodes without inputs
+    ASSERT_EQ(snapshot.levels.size(), 3);
+    ASSERT_EQ(snapshot.levels[0].count(), 0);
+    ASSERT_EQ(snapshot.levels[1].count(), 4);
+    ASSERT_GE(snapshot.levels[2].count(), 3);
+    ASSERT_LE(snapshot.queue.percentile(50.0), snapshot.queue.max());
+
+    latency.reset();
+    ASSERT_EQ(latency.snapshot().queue.count(), 0);
+    ASSERT_TRUE(latency.snapshot().levels.empty());
+}
+
+TEST(gate, probe_multi)
+{
+    struct Shed final: nil::gate::IProbe
+    {
+        const nil::gate::INode* node = nullptr;
+
+        bool shed(const nil::gate::INode& n) override
+        {
+            return &n == node;
+        }
+    };
+
+    nil::gate::runners::SoftBlocking runner;
+    nil::gate::Core core(&runner);
+    nil::gate::probes::Stats stats;
+    nil::gate::probes::Latency latency;
+    Shed shed;
+    nil::gate::probes::Multi probes({&stats, &latency});
+    probes.add(&shed);
+    core.set_probe(&probes);
+
+    nil::gate::ports::External<int>* a = nullptr;
+    nil::gate::INode* first = nullptr;
+    nil::gate::INode* second = nullptr;
+    auto runs = 0;
+    core.apply(
+        [&](nil::gate::Graph& graph)
+        {
+            a = graph.port(1);
+            first = graph.node([&](int) { ++runs; }, {a});
+            second = graph.node([&](int) { ++runs; }, {a});
+        }
+    );
+    ASSERT_EQ(runs, 2);
+
+    shed.node = second;
+    core.apply([&]() { a->to_direct()->set_value(2); });
+    ASSERT_EQ(runs, 3);
+    ASSERT_EQ(stats.get(first).exec_count, 2U);
+    ASSERT_EQ(stats.get(second).exec_count, 1U);
+    ASSERT_EQ(latency.snapshot().commit.count(), 2);
+
+    probes.remove(&stats);
+    core.apply([&]() { a->to_direct()->set_value(3); });
+    ASSERT_EQ(stats.get(first).exec_count, 2U);
+    ASSERT_EQ(latency.snapshot().commit.count(), 3);
+}
+
+TEST(gate, probe_multi_same_class)
+{
+    using ESource = nil::gate::probes::Counters::ESource;
+
+    const auto burn = [](std::chrono::milliseconds duration)
+    {
+        const auto until = std::chrono::steady_clock::now() + duration;
+        while (std::chrono::steady_clock::now() < until)
+        {
+        }
+    };
+
+    nil::gate::runners::SoftBlocking runner;
+    nil::gate::Core core(&runner);
+    // both share the per thread stack of Stats, each has to end its own execution
+    nil::gate::probes::Stats with_counters(nil::gate::probes::Stats::ECounters::On);
+    nil::gate::probes::Stats without_counters;
+    nil::gate::probes::Multi probes({&with_counters, &without_counters});
+    core.set_probe(&probes);
+
+    // cpu time of the thread before the executions, read as a whole if the stack is mixed up
+    const auto source = nil::gate::probes::Counters::this_thread().source();
+    burn(std::chrono::milliseconds(50));
+
+    nil::gate::ports::External<int>* a = nullptr;
+    nil::gate::INode* busy = nullptr;
+    core.apply(
+        [&](nil::gate::Graph& graph)
+        {
+            a = graph.port(0);
+            busy = graph.node(
+                [&](int v)
+                {
+                    burn(std::chrono::milliseconds(1));
+                    return v;
+                },
+                {a}
+            );
+        }
+    );
+    for (auto i = 1; i < 5; ++i)
+    {
+        core.apply([&, i]() { a->to_direct()->set_value(i); });
+    }
+
+    const auto s = with_counters.get(busy);
+    ASSERT_EQ(s.exec_count, 5U);
+    ASSERT_EQ(without_counters.get(busy).exec_count, 5U);
+    ASSERT_EQ(without_counters.get(busy).counters.cpu_time, std::chrono::nanoseconds(0));
+    if (source != ESource::None)
+    {
+        ASSERT_GT(s.counters.cpu_time, std::chrono::milliseconds(1));
+        ASSERT_LT(s.counters.cpu_time, std::chrono::milliseconds(40));
+    }
+}
+
+namespace
+{
+    struct Celsius
+    {
+        double value;
+
+        bool operator==(const Celsius&) const = default;
+    };
+}
+
+template <>
+struct nil::gate::traits::compatibility<Celsius, int>
+{
+    static Celsius convert(int v)
+    {
+        return {double(v)};
+    }
+};
+
+TEST(gate, topology)
+{
+    nil::gate::runners::SoftBlocking runner;
+    nil::gate::Core core(&runner);
+    nil::gate::probes::Stats stats;
+    core.set_probe(&stats);
+
+    nil::gate::INode* source = nullptr;
+    nil::gate::INode* convert = nullptr;
+    core.apply(
+        [&](nil::gate::Graph& graph)
+        {
+            auto* a = graph.port(1);
+            auto* b = graph.port(2);
+            auto* s = graph.node([](int v) { return v; }, {a});
+            source = s;
+            auto* out = get<0>(s->outputs());
+            convert = graph.node([](const Celsius& c) { return c.value; }, {out});
+            graph.node([](int, int) {}, {out, nil::gate::passive(b)});
+            graph.node([](int) {}, {b});
+        }
+    );
+
+    core.apply(
+        [&](nil::gate::Graph& graph)
+        {
+            const auto t = nil::gate::Topology::of(graph);
+            ASSERT_EQ(t.node_count, 4U);
+            ASSERT_EQ(t.depth, 2U);
+            ASSERT_EQ(t.widths, (std::vector<std::size_t>{0, 2, 2}));
+            ASSERT_EQ(t.fan_in, (std::vector<std::size_t>{0, 3, 1}));
+            ASSERT_EQ(t.fan_out, (std::vector<std::size_t>{3, 0, 1}));
+            ASSERT_EQ(t.edges.size(), 5U);
+
+            ASSERT_EQ(t.adapters.size(), 1U);
+            ASSERT_EQ(t.adapters[0].from, source);
+            ASSERT_EQ(t.adapters[0].to, convert);
+            ASSERT_EQ(t.adapters[0].kind, nil::gate::INode::EInput::Convert);
+
+            std::ostringstream oss;
+            nil::gate::write_dot(oss, graph, &stats);
+            const auto dot = oss.str();
+            ASSERT_THAT(dot, testing::StartsWith("digraph nil_gate {"));
+            ASSERT_THAT(dot, testing::HasSubstr("label=\"convert\""));
+            ASSERT_THAT(dot, testing::HasSubstr("style=dashed"));
+            ASSERT_THAT(dot, testing::HasSubstr("exec 1, skip 0"));
+            ASSERT_THAT(dot, testing::HasSubstr("shape=ellipse"));
+        }
+    );
+}
+
+TEST(gate, conflated_set_value)
+{
+    nil::gate::runners::SoftBlocking runner;
+    nil::gate::Core core(&runner);
+
+    const testing::InSequence seq;
+    testing::StrictMock<testing::MockFunction<void(int)>> foo;
+
+    nil::gate::ports::External<int>* port = nullptr;
+
+    EXPECT_CALL(foo, Call(0)).Times(1).RetiresOnSaturation();
+    core.apply(
+        [&](nil::gate::Graph& graph)
+        {
+            port = graph.port(0);
+            graph.node([&foo](int v) { foo.Call(v); }, {port});
+        }
+    );
+
+    auto* feed = core.conflate(port);
+
+    std::thread producer(
+        [feed]()
+        {
+            for (int i = 1; i <= 1000; ++i)
+            {
+                feed->set_value(i);
+            }
+        }
+    );
+    producer.join();
+
+    // only the latest value is applied
+    EXPECT_CALL(foo, Call(1000)).Times(1).RetiresOnSaturation();
+    core.commit();
+
+    // nothing staged
+    core.commit();
+
+    feed->set_value(5);
+    feed->unset_value();
+    core.commit();
+    ASSERT_FALSE(port->to_direct()->has_value());
+
+    EXPECT_CALL(foo, Call(7)).Times(1).RetiresOnSaturation();
+    feed->set_value(7);
+    core.commit();
+
+    // a value staged on a released handle is dropped with it
+    feed->set_value(9);
+    core.remove(feed);
+    core.apply([&](nil::gate::Graph& graph) { graph.remove(port); });
+    core.commit();
+}
+
+TEST(gate, post_from_threads)
+{
+    nil::gate::runners::SoftBlocking runner;
+    nil::gate::Core core(&runner);
+
+    constexpr auto thread_count = 4;
+    constexpr auto post_count = 1000;
+
+    std::array<int, thread_count> last = {};
+    bool ordered = true;
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < thread_count; ++t)
+    {
+        producers.emplace_back(
+            [&, t]()
+            {
+                for (int i = 1; i <= post_count; ++i)
+                {
+                    core.post(
+                        [&, t, i]()
+                        {
+                            ordered = ordered && (last[t] + 1 == i);
+                            last[t] = i;
+                        }
+                    );
+                }
+            }
+        );
+    }
+    for (auto& p : producers)
+    {
+        p.join();
+    }
+
+    core.commit();
+
+    ASSERT_TRUE(ordered);
+    for (const auto& l : last)
+    {
+        ASSERT_EQ(l, post_count);
+    }
+}
+
+TEST(gate, post_snapshot_at_commit)
+{
+    // holds the commits like a busy async runner until `release`
+    struct Held final: nil::gate::IRunner
+    {
+        std::vector<nil::gate::Callable<std::span<nil::gate::INode* const>()>> commits;
+
+        void run(nil::gate::Callable<std::span<nil::gate::INode* const>()> apply_changes) override
+        {
+            commits.emplace_back(std::move(apply_changes));
+        }
+
+        void release()
+        {
+            for (auto& commit : std::exchange(commits, {}))
+            {
+                commit();
+            }
+        }
+    };
+
+    Held runner;
+    nil::gate::Core core(&runner);
+
+    std::vector<std::vector<int>> passes;
+    core.post([&]() { passes.push_back({1}); });
+    core.post([&]() { passes.back().push_back(2); });
+    core.commit();
+    // posted after the commit, belongs to the next one even if the first is not applied yet
+    core.post([&]() { passes.push_back({3}); });
+
+    runner.release();
+    ASSERT_EQ(passes, (std::vector<std::vector<int>>{{1, 2}}));
+
+    core.commit();
+    runner.release();
+    ASSERT_EQ(passes, (std::vector<std::vector<int>>{{1, 2}, {3}}));
+
+    // dropped without being applied
+    core.post([&]() { passes.clear(); });
+    core.commit();
+    runner.commits.clear();
+    ASSERT_EQ(passes.size(), 2U);
+}
+
+TEST(gate, async_affinity)
+{
+    using runner_t = nil::gate::runners::Async;
+
+    // runner is destroyed first so that no task is in flight when the core is destroyed
+    nil::gate::Core core;
+    runner_t runner(2);
+    core.set_runner(&runner);
+
+    // nodes with affinity 1 are run by this thread
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<runner_t::Task> tasks;
+    runner.set_executor(
+        1,
+        [&](runner_t::Task task)
+        {
+            {
+                const std::lock_guard lock(mutex);
+                tasks.push_back(std::move(task));
+            }
+            cv.notify_one();
+        }
+    );
+
+    const auto this_id = std::this_thread::get_id();
+    std::thread::id owner_id;
+    std::thread::id dedicated_id;
+    std::atomic<int> last = 0;
+
+    nil::gate::ports::External<int>* a = nullptr;
+    core.apply(
+        [&](nil::gate::Graph& graph)
+        {
+            a = graph.port<int>();
+            auto [x] = graph.node([](int v) { return v + 1; }, {a})->outputs();
+
+            auto* owned = graph.node(
+                [&](int v)
+                {
+                    owner_id = std::this_thread::get_id();
+                    return v * 2;
+                },
+                {x}
+            );
+            owned->set_affinity(1);
+
+            // no executor for affinity 2, runs on a thread of its own
+            auto* dedicated = graph.node(
+                [&](int v)
+                {
+                    dedicated_id = std::this_thread::get_id();
+                    last = v;
+                },
+                {get<0>(owned->outputs())}
+            );
+            dedicated->set_affinity(2);
+        }
+    );
+
+    std::thread::id previous_dedicated_id;
+    for (auto i = 1; i <= 3; ++i)
+    {
+        core.apply([&]() { a->to_direct()->set_value(i); });
+
+        std::unique_lock lock(mutex);
+        cv.wait(lock, [&]() { return !tasks.empty(); });
+        auto task = std::move(tasks.front());
+        tasks.clear();
+        lock.unlock();
+        task();
+
+        while (last != (i + 1) * 2)
+        {
+            std::this_thread::yield();
+        }
+        ASSERT_EQ(owner_id, this_id);
+        ASSERT_NE(dedicated_id, this_id);
+        if (i > 1)
+        {
+            ASSERT_EQ(dedicated_id, previous_dedicated_id);
+        }
+        previous_dedicated_id = dedicated_id;
+    }
+}
+
+TEST(gate, callable_inline_and_heap)
+{
+    using callable_t = nil::gate::Callable<int(int)>;
+    using big_t = std::array<char, 64>;
+
+    auto small = [p = std::make_unique<int>(1)](int v) { return *p + v; };
+    auto big = [p = std::make_unique<int>(2), b = big_t()](int v) { return *p + v + b[0]; };
+    static_assert(callable_t::is_inline<decltype(small)>);
+    static_assert(!callable_t::is_inline<decltype(big)>);
+
+    callable_t c1 = std::move(small);
+    callable_t c2 = std::move(big);
+    ASSERT_EQ(c1(1), 2);
+    ASSERT_EQ(c2(1), 3);
+
+    callable_t c3 = std::move(c1);
+    ASSERT_FALSE(c1); // NOLINT(bugprone-use-after-move)
+    ASSERT_EQ(c3(2), 3);
+
+    c3 = std::move(c2);
+    ASSERT_FALSE(c2); // NOLINT(bugprone-use-after-move)
+    ASSERT_EQ(c3(2), 4);
+
+    c3 = nullptr;
+    ASSERT_FALSE(c3);
+}